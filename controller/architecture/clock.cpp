@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "clock.hpp"
+
+#ifdef PLATFORM_HOSTED
+
+namespace architecture::clock
+{
+namespace detail
+{
+bool virtualTimeEnabled = false;
+uint64_t virtualTimeUs = 0;
+}  // namespace detail
+
+void useVirtualTime(uint64_t startUs)
+{
+    detail::virtualTimeUs = startUs;
+    detail::virtualTimeEnabled = true;
+}
+
+void useRealTime() { detail::virtualTimeEnabled = false; }
+
+void advance(uint32_t us)
+{
+    if (detail::virtualTimeEnabled)
+    {
+        detail::virtualTimeUs += us;
+    }
+}
+
+void advanceTo(uint32_t timeUs)
+{
+    int32_t ahead = static_cast<int32_t>(timeUs - getTimeMicroseconds());
+    if (ahead > 0)
+    {
+        advance(ahead);
+    }
+}
+}  // namespace architecture::clock
+
+#endif
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "tap/architecture/clock.hpp"
+
+#include "modm/architecture/interface/delay.hpp"
+
+/**
+ * @brief The time source for everything in this project that reads the clock or waits.
+ *
+ * On the board this forwards to `tap::arch::clock` and `modm::delay_us`. Hosted builds can switch
+ * it to virtual time, which only moves when it is advanced, either explicitly or by
+ * `delayMicroseconds`. Tests and simulations then run the robot loop deterministically and as
+ * fast as the host allows.
+ *
+ * Taproot's own drivers keep reading `tap::arch::clock`, so timestamps they take (IMU samples,
+ * remote and referee timeouts) stay in real time.
+ */
+namespace architecture::clock
+{
+#ifdef PLATFORM_HOSTED
+namespace detail
+{
+extern bool virtualTimeEnabled;
+extern uint64_t virtualTimeUs;
+}  // namespace detail
+
+/**
+ * Stops the clock at `startUs` and makes it virtual from then on.
+ */
+void useVirtualTime(uint64_t startUs = 0);
+
+/**
+ * Returns the clock to the host's real time.
+ */
+void useRealTime();
+
+inline bool isVirtualTime() { return detail::virtualTimeEnabled; }
+
+/**
+ * Moves virtual time forward by `us`. Does nothing in real time.
+ */
+void advance(uint32_t us);
+
+/**
+ * Moves virtual time forward to `timeUs`, interpreted like `getTimeMicroseconds`, unless it is
+ * already past it. Does nothing in real time.
+ */
+void advanceTo(uint32_t timeUs);
+#endif
+
+inline uint32_t getTimeMicroseconds()
+{
+#ifdef PLATFORM_HOSTED
+    if (detail::virtualTimeEnabled)
+    {
+        return static_cast<uint32_t>(detail::virtualTimeUs);
+    }
+#endif
+    return tap::arch::clock::getTimeMicroseconds();
+}
+
+inline uint32_t getTimeMilliseconds()
+{
+#ifdef PLATFORM_HOSTED
+    if (detail::virtualTimeEnabled)
+    {
+        return static_cast<uint32_t>(detail::virtualTimeUs / 1'000);
+    }
+#endif
+    return tap::arch::clock::getTimeMilliseconds();
+}
+
+/**
+ * Busy waits for `us`, or advances virtual time by it.
+ */
+inline void delayMicroseconds(uint32_t us)
+{
+#ifdef PLATFORM_HOSTED
+    if (detail::virtualTimeEnabled)
+    {
+        advance(us);
+        return;
+    }
+#endif
+    modm::delay_us(us);
+}
+}  // namespace architecture::clock
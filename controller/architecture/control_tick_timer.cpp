@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "control_tick_timer.hpp"
+
+namespace architecture
+{
+ControlTickTimer::ControlTickTimer(
+    uint32_t periodUs,
+    uint32_t feedbackPeriodUs,
+    uint32_t phaseOffsetUs)
+    : periodUs(periodUs),
+      feedbackPeriodUs(feedbackPeriodUs),
+      phaseOffsetUs(phaseOffsetUs)
+{
+}
+
+bool ControlTickTimer::execute(uint32_t now, uint32_t lastFeedbackUs)
+{
+    int32_t untilDeadline = static_cast<int32_t>(nextTickUs - now);
+    if (untilDeadline > 0)
+    {
+        return false;
+    }
+
+    lateUs = started ? static_cast<uint32_t>(-untilDeadline) : 0;
+    started = true;
+
+    // Fell more than a period behind (or first call), resynchronize instead of bursting ticks
+    if (-untilDeadline >= static_cast<int32_t>(periodUs))
+    {
+        nextTickUs = now;
+    }
+
+    phaseError = 0;
+    if (lastFeedbackUs != 0)
+    {
+        int32_t phase = static_cast<int32_t>((now - lastFeedbackUs) % feedbackPeriodUs);
+        phaseError = phase - static_cast<int32_t>(phaseOffsetUs);
+
+        int32_t feedbackPeriod = static_cast<int32_t>(feedbackPeriodUs);
+        if (phaseError >= feedbackPeriod / 2)
+        {
+            phaseError -= feedbackPeriod;
+        }
+        else if (phaseError < -feedbackPeriod / 2)
+        {
+            phaseError += feedbackPeriod;
+        }
+    }
+
+    nextTickUs += static_cast<int32_t>(periodUs) - (phaseError >> PHASE_CORRECTION_SHIFT);
+    return true;
+}
+}  // namespace architecture
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace architecture
+{
+/**
+ * @brief Periodic timer for the control tick that phase locks itself to the motors' feedback.
+ *
+ * DJI motor controllers send feedback at a fixed rate that is not synchronized to the MCB. Starting
+ * the control tick a fixed, short time after a feedback frame arrives minimizes how stale that
+ * feedback is when it is used. Each time the timer fires, the phase of the tick relative to the
+ * most recent feedback frame is measured and the next deadline is nudged a fraction of the way
+ * towards `phaseOffsetUs`.
+ */
+class ControlTickTimer
+{
+public:
+    /// Fraction of the measured phase error corrected per tick, as a right shift.
+    static constexpr uint8_t PHASE_CORRECTION_SHIFT = 2;
+
+    /**
+     * @param[in] periodUs control tick period.
+     * @param[in] feedbackPeriodUs period at which motor feedback frames arrive.
+     * @param[in] phaseOffsetUs desired delay between a feedback frame arriving and the tick.
+     */
+    ControlTickTimer(uint32_t periodUs, uint32_t feedbackPeriodUs, uint32_t phaseOffsetUs);
+
+    /**
+     * @param[in] now the current time, in microseconds.
+     * @param[in] lastFeedbackUs the time the most recent feedback frame arrived, or 0 if none has,
+     * in which case the timer runs at a fixed period.
+     * @return true if a control tick is due, in which case the next deadline is scheduled.
+     */
+    bool execute(uint32_t now, uint32_t lastFeedbackUs);
+
+    /**
+     * @return the time the next tick is due, in microseconds.
+     */
+    uint32_t getNextTickTime() const { return nextTickUs; }
+
+    /**
+     * @return the phase error measured at the last tick, in microseconds.
+     */
+    int32_t getPhaseError() const { return phaseError; }
+
+    /**
+     * @return how long after its deadline the last tick fired, in microseconds. 0 for the first
+     * tick, which has no deadline.
+     */
+    uint32_t getLateness() const { return lateUs; }
+
+private:
+    const uint32_t periodUs;
+    const uint32_t feedbackPeriodUs;
+    const uint32_t phaseOffsetUs;
+
+    bool started{false};
+    uint32_t nextTickUs{0};
+    int32_t phaseError{0};
+    uint32_t lateUs{0};
+};
+}  // namespace architecture
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "cycle_counter.hpp"
+
+#ifdef PLATFORM_HOSTED
+#include <ctime>
+#endif
+
+namespace architecture::cycle_counter
+{
+#ifdef PLATFORM_HOSTED
+namespace detail
+{
+uint64_t frequencyHz = 1'000'000'000;
+}  // namespace detail
+
+static uint64_t monotonicNanoseconds()
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1'000'000'000ull + now.tv_nsec;
+}
+
+void initialize()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    // The TSC runs at a fixed rate on any host recent enough to matter; measure it over 10 ms
+    static constexpr uint64_t CALIBRATION_NS = 10'000'000;
+
+    uint64_t startNs = monotonicNanoseconds();
+    uint64_t startTicks = __rdtsc();
+    uint64_t elapsedNs;
+    do
+    {
+        elapsedNs = monotonicNanoseconds() - startNs;
+    } while (elapsedNs < CALIBRATION_NS);
+    uint64_t ticks = __rdtsc() - startTicks;
+
+    detail::frequencyHz = ticks * 1'000'000'000ull / elapsedNs;
+#endif
+}
+#else
+void initialize()
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+#endif
+}  // namespace architecture::cycle_counter
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#ifdef PLATFORM_HOSTED
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <ctime>
+#endif
+#else
+#include "modm/platform/device.hpp"
+#endif
+
+/**
+ * @brief A free running 32 bit cycle counter, for timing code too short for the microsecond clock.
+ *
+ * On the board this is the Cortex-M4 DWT cycle counter, which counts core clock cycles and costs
+ * a single load to read. Hosted builds count x86 time stamp counter ticks, calibrated against the
+ * monotonic clock, or nanoseconds of the monotonic clock on other hosts.
+ *
+ * The counter wraps, every ~24 s on the board, so only differences of nearby reads are meaningful.
+ */
+namespace architecture::cycle_counter
+{
+#ifndef PLATFORM_HOSTED
+/// Core clock of the RoboMaster development board type A.
+constexpr uint64_t CORE_CLOCK_HZ = 180'000'000;
+#else
+namespace detail
+{
+extern uint64_t frequencyHz;
+}  // namespace detail
+#endif
+
+/**
+ * Starts the counter. Call once before the first `read`.
+ */
+void initialize();
+
+inline uint32_t read()
+{
+#ifndef PLATFORM_HOSTED
+    return DWT->CYCCNT;
+#elif defined(__x86_64__) || defined(__i386__)
+    return static_cast<uint32_t>(__rdtsc());
+#else
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint32_t>(now.tv_sec * 1'000'000'000ull + now.tv_nsec);
+#endif
+}
+
+/**
+ * @return counts per second.
+ */
+inline uint64_t getFrequencyHz()
+{
+#ifndef PLATFORM_HOSTED
+    return CORE_CLOCK_HZ;
+#else
+    return detail::frequencyHz;
+#endif
+}
+
+/**
+ * @return `cycles` in nanoseconds.
+ */
+inline uint32_t toNanoseconds(uint32_t cycles)
+{
+    return static_cast<uint32_t>(cycles * 1'000'000'000ull / getFrequencyHz());
+}
+}  // namespace architecture::cycle_counter
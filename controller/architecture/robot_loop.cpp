@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "robot_loop.hpp"
+
+#include "communication/can/can_rx_drain.hpp"
+#include "control/motor/timestamped_dji_motor.hpp"
+#include "diagnostics/cycle_profiler.hpp"
+#include "diagnostics/trace_buffer.hpp"
+
+#include "clock.hpp"
+#include "drivers.hpp"
+
+namespace architecture
+{
+RobotLoop::RobotLoop(Drivers &drivers)
+    : drivers(drivers),
+      controlTickTimer(CONTROL_PERIOD_US, MOTOR_FEEDBACK_PERIOD_US, CONTROL_TICK_PHASE_OFFSET_US)
+{
+}
+
+bool RobotLoop::step()
+{
+    // do this as fast as you can
+    CYCLE_PROFILE(drivers.cycleProfiler, updateIo, ());
+
+    if (!controlTickDue())
+    {
+        return false;
+    }
+
+    runControlTick();
+    return true;
+}
+
+void RobotLoop::run()
+{
+    while (1)
+    {
+        step();
+        clock::delayMicroseconds(IDLE_DELAY_US);
+    }
+}
+
+#ifdef PLATFORM_HOSTED
+uint64_t RobotLoop::runTicks(uint32_t ticks)
+{
+    if (!clock::isVirtualTime())
+    {
+        clock::useVirtualTime(clock::getTimeMicroseconds());
+    }
+
+    uint64_t iterations = 0;
+    for (uint32_t ran = 0; ran < ticks; iterations++)
+    {
+        if (step())
+        {
+            ran++;
+        }
+
+        clock::advance(IDLE_DELAY_US);
+        clock::advanceTo(controlTickTimer.getNextTickTime());
+    }
+    return iterations;
+}
+#endif
+
+void RobotLoop::runControlTick()
+{
+    TRACE_SCOPE(drivers.traceBuffer, "control tick");
+    drivers.overrunMonitor.checkTick(controlTickTimer.getLateness());
+
+    if constexpr (LATENCY_OPTIMIZED_TICK)
+    {
+        CYCLE_PROFILE(drivers.cycleProfiler, readControlInputs, ());
+    }
+    else
+    {
+        CYCLE_PROFILE(drivers.cycleProfiler, communication::can::drainReceiveQueue, (drivers));
+    }
+
+    {
+        // Commands and subsystems trace their own execute and refresh inside this scope
+        TRACE_SCOPE(drivers.traceBuffer, "command scheduler");
+        CYCLE_PROFILE(drivers.cycleProfiler, drivers.commandScheduler.run, ());
+    }
+    bool motorFrameSent;
+    {
+        CYCLE_PROFILE_SCOPE(drivers.cycleProfiler, "drivers.canTxScheduler.sendFrames");
+        motorFrameSent = drivers.canTxScheduler.sendFrames();
+    }
+    drivers.latencyTracer.endTick(clock::getTimeMicroseconds(), motorFrameSent);
+
+    // Shed while ticks start late, so control keeps its rate
+    if (drivers.overrunMonitor.isNonCriticalWorkDue())
+    {
+        CYCLE_PROFILE(drivers.cycleProfiler, drivers.terminalSerial.update, ());
+    }
+
+    tickCount++;
+}
+
+void RobotLoop::updateIo()
+{
+    TRACE_SCOPE(drivers.traceBuffer, "update io");
+
+    CYCLE_PROFILE(drivers.cycleProfiler, communication::can::drainReceiveQueue, (drivers));
+    CYCLE_PROFILE(drivers.cycleProfiler, drivers.refSerial.updateSerial, ());
+    CYCLE_PROFILE(drivers.cycleProfiler, readRemote, ());
+    updateImu();
+}
+
+void RobotLoop::readRemote()
+{
+#if defined(PLATFORM_HOSTED) && !defined(ENV_UNIT_TESTS)
+    drivers.virtualRemote.read();
+#else
+    drivers.remote.read();
+#endif
+    drivers.controlOperatorInterface.updateRemoteFrameTime();
+}
+
+bool RobotLoop::controlTickDue()
+{
+    // Without feedback times the timer ticks at a fixed period
+    uint32_t lastFeedbackUs = LATENCY_OPTIMIZED_TICK && phaseReference != nullptr
+                                  ? phaseReference->getLastFeedbackTime()
+                                  : 0;
+    return controlTickTimer.execute(clock::getTimeMicroseconds(), lastFeedbackUs);
+}
+
+void RobotLoop::readControlInputs()
+{
+    communication::can::drainReceiveQueue(drivers);
+    readRemote();
+    updateImu();
+}
+
+void RobotLoop::updateImu()
+{
+    TRACE_SCOPE(drivers.traceBuffer, "imu update");
+    CYCLE_PROFILE(drivers.cycleProfiler, drivers.imuPipeline.update, ());
+}
+}  // namespace architecture
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "control_tick_timer.hpp"
+
+class Drivers;
+
+namespace control::motor
+{
+class TimestampedDjiMotor;
+}
+
+namespace architecture
+{
+/**
+ * @brief The body of the main loop, one iteration at a time.
+ *
+ * `main` initializes the drivers and the robot, then calls `run`. Keeping the iteration in
+ * `step` lets hosted tests and simulations drive the loop themselves: with the clock in virtual
+ * time (see clock.hpp), `runTicks` goes through millions of control ticks deterministically and
+ * as fast as the host allows.
+ */
+class RobotLoop
+{
+public:
+    /// When set, the control tick reads the remote, IMU and motor feedback itself right before the
+    /// scheduler runs and starts a fixed offset after motor feedback arrives, rather than using
+    /// whatever the free running IO update last read.
+    static constexpr bool LATENCY_OPTIMIZED_TICK = true;
+    static constexpr uint32_t CONTROL_PERIOD_US = 2'000;
+    static constexpr uint32_t MOTOR_FEEDBACK_PERIOD_US = 1'000;
+    static constexpr uint32_t CONTROL_TICK_PHASE_OFFSET_US = 100;
+    /// Time `run` waits between iterations.
+    static constexpr uint32_t IDLE_DELAY_US = 10;
+
+    RobotLoop(Drivers &drivers);
+
+    const ControlTickTimer &getControlTickTimer() const { return controlTickTimer; }
+
+    /**
+     * Sets the motor whose feedback frames the control tick phase locks to when
+     * LATENCY_OPTIMIZED_TICK is set. Until one is set the tick runs at a fixed period.
+     */
+    void setPhaseReference(const control::motor::TimestampedDjiMotor *motor)
+    {
+        phaseReference = motor;
+    }
+
+    /**
+     * Runs one iteration of the main loop: the free running IO update and, if it is due, the
+     * control tick.
+     *
+     * @return whether a control tick ran.
+     */
+    bool step();
+
+    /**
+     * Steps forever, waiting `IDLE_DELAY_US` between iterations.
+     */
+    [[noreturn]] void run();
+
+#ifdef PLATFORM_HOSTED
+    /**
+     * Steps until `ticks` control ticks have run, in virtual time. After each iteration the clock
+     * jumps straight to the next tick's deadline instead of idling towards it, so a tick costs
+     * one or two iterations. The clock is switched to virtual time if it is not already.
+     *
+     * @return the number of iterations run.
+     */
+    uint64_t runTicks(uint32_t ticks);
+#endif
+
+    /**
+     * @return the number of control ticks run so far.
+     */
+    uint32_t getTickCount() const { return tickCount; }
+
+private:
+    Drivers &drivers;
+
+    ControlTickTimer controlTickTimer;
+    const control::motor::TimestampedDjiMotor *phaseReference{nullptr};
+
+    uint32_t tickCount{0};
+
+    /// Runs every iteration, as often as the loop spins.
+    void updateIo();
+
+    /// Reads the remote, the virtual remote in hosted builds, and records when its frame arrived.
+    void readRemote();
+
+    /// Updates the IMU pipeline, traced and profiled wherever it is called from.
+    void updateImu();
+
+    /// Reads every input the control tick consumes. Only called when LATENCY_OPTIMIZED_TICK is set.
+    void readControlInputs();
+
+    /// Whether the control tick should run now.
+    bool controlTickDue();
+
+    void runControlTick();
+};
+}  // namespace architecture
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "can_rx_drain.hpp"
+
+#include "drivers.hpp"
+
+using tap::can::CanBus;
+
+namespace communication::can
+{
+void drainReceiveQueue(Drivers &drivers)
+{
+    for (uint8_t i = 0; i < MAX_FRAMES_PER_DRAIN; i++)
+    {
+#if defined(PLATFORM_HOSTED) && !defined(ENV_UNIT_TESTS)
+        if (!drivers.socketCanBridge.pollCanData())
+        {
+            return;
+        }
+#else
+        if (!drivers.can.isMessageAvailable(CanBus::CAN_BUS1) &&
+            !drivers.can.isMessageAvailable(CanBus::CAN_BUS2))
+        {
+            return;
+        }
+
+        drivers.canRxHandler.pollCanData();
+#endif
+    }
+}
+}  // namespace communication::can
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+class Drivers;
+
+namespace communication::can
+{
+/// Upper bound on frames dispatched per drain, so a flooded bus cannot starve the main loop.
+static constexpr uint8_t MAX_FRAMES_PER_DRAIN = 16;
+
+/**
+ * Dispatches every frame waiting in the CAN receive queues to its listeners.
+ *
+ * The CAN driver's receive interrupt pushes incoming frames into a lock-free queue per bus, but
+ * `CanRxHandler::pollCanData` only takes one frame per bus off those queues per call. Calling this
+ * right before the feedback is needed keeps motor data as fresh as the bus allows instead of as
+ * fresh as the busy loop happens to be.
+ */
+void drainReceiveQueue(Drivers &drivers);
+}  // namespace communication::can
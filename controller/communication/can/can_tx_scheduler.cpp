@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "can_tx_scheduler.hpp"
+
+#include <cstring>
+
+#include "tap/motor/dji_motor.hpp"
+
+#include "architecture/clock.hpp"
+#include "diagnostics/trace_buffer.hpp"
+
+#include "drivers.hpp"
+
+using tap::motor::DjiMotor;
+
+namespace communication::can
+{
+CanTxScheduler::CanTxScheduler(Drivers &drivers) : drivers(drivers) {}
+
+void CanTxScheduler::init() { drivers.terminalSerial.addHeader("cantx", this); }
+
+void CanTxScheduler::addMotor(DjiMotor *motor)
+{
+#if defined(PLATFORM_HOSTED) && !defined(ENV_UNIT_TESTS)
+    drivers.socketCanBridge.attachListener(motor);
+#endif
+
+    uint32_t slot = motor->getMotorIdentifier() - tap::motor::MOTOR1;
+    MotorFrame &frame =
+        buses[busIndex(motor->getCanBus())].frames[slot / MOTORS_PER_FRAME];
+    frame.motors[slot % MOTORS_PER_FRAME] = motor;
+}
+
+bool CanTxScheduler::sendFrames()
+{
+    TRACE_SCOPE(drivers.traceBuffer, "can tx");
+
+    uint32_t now = architecture::clock::getTimeMicroseconds();
+
+    bool motorFrameSent = false;
+    for (uint8_t bus = 0; bus < NUM_BUSES; bus++)
+    {
+        motorFrameSent |= sendMotorFrames(bus, now);
+    }
+    updateBusLoad(now);
+    return motorFrameSent;
+}
+
+bool CanTxScheduler::sendMotorFrames(uint8_t bus, uint32_t now)
+{
+    bool sent = false;
+    for (uint8_t i = 0; i < FRAMES_PER_BUS; i++)
+    {
+        MotorFrame &frame = buses[bus].frames[i];
+
+        std::array<uint8_t, 8> payload{};
+        bool hasMotors = false;
+        for (uint8_t slot = 0; slot < MOTORS_PER_FRAME; slot++)
+        {
+            const DjiMotor *motor = frame.motors[slot];
+            if (motor == nullptr)
+            {
+                continue;
+            }
+
+            int16_t output = motor->getOutputDesired();
+            payload[2 * slot] = static_cast<uint16_t>(output) >> 8;
+            payload[2 * slot + 1] = static_cast<uint16_t>(output) & 0xff;
+            hasMotors = true;
+        }
+
+        if (!hasMotors)
+        {
+            continue;
+        }
+
+        if (frame.everSent && payload == frame.lastPayload &&
+            now - frame.lastSentUs < KEEPALIVE_PERIOD_US)
+        {
+            buses[bus].motorFramesCoalesced++;
+            continue;
+        }
+
+        modm::can::Message message(FRAME_IDENTIFIERS[i], payload.size());
+        message.setExtended(false);
+        std::memcpy(message.data, payload.data(), payload.size());
+
+        if (send(bus, message))
+        {
+            frame.lastPayload = payload;
+            frame.lastSentUs = now;
+            frame.everSent = true;
+            buses[bus].motorFramesSent++;
+            sent = true;
+        }
+    }
+    return sent;
+}
+
+bool CanTxScheduler::send(uint8_t bus, const modm::can::Message &message)
+{
+    BusState &state = buses[bus];
+
+#if defined(PLATFORM_HOSTED) && !defined(ENV_UNIT_TESTS)
+    if (!drivers.socketCanBridge.sendMessage(busFromIndex(bus), message))
+#else
+    if (!drivers.can.sendMessage(busFromIndex(bus), message))
+#endif
+    {
+        state.framesFailed++;
+        return false;
+    }
+
+    state.bitsThisWindow += BITS_PER_FRAME;
+    return true;
+}
+
+void CanTxScheduler::updateBusLoad(uint32_t now)
+{
+    uint32_t elapsed = now - windowStartUs;
+    if (elapsed < LOAD_WINDOW_US)
+    {
+        return;
+    }
+
+    for (auto &bus : buses)
+    {
+        bus.load = static_cast<float>(bus.bitsThisWindow) / BUS_BITRATE /
+                   (static_cast<float>(elapsed) / 1'000'000);
+        bus.bitsThisWindow = 0;
+    }
+
+    windowStartUs = now;
+}
+
+bool CanTxScheduler::terminalSerialCallback(char *, modm::IOStream &outputStream, bool)
+{
+    for (uint8_t i = 0; i < NUM_BUSES; i++)
+    {
+        const BusState &bus = buses[i];
+        outputStream << "CAN" << (i + 1) << ": load " << bus.load * 100 << "%, motor frames "
+                     << bus.motorFramesSent << " sent / " << bus.motorFramesCoalesced
+                     << " coalesced, failed " << bus.framesFailed << modm::endl;
+    }
+    return true;
+}
+}  // namespace communication::can
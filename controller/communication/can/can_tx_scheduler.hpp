@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "tap/communication/can/can_bus.hpp"
+#include "tap/communication/serial/terminal_serial.hpp"
+
+#include "modm/architecture/interface/can_message.hpp"
+
+class Drivers;
+
+namespace tap::motor
+{
+class DjiMotor;
+}
+
+namespace communication::can
+{
+/**
+ * @brief Sends the motors' CAN frames, packed and coalesced.
+ *
+ * Replaces `DjiMotorTxHandler::encodeAndSendCanData` in the main loop. Registered motors are
+ * packed four to a frame by their DJI command identifier (0x200 for motors 1-4, 0x1FF for motors
+ * 5-8), and only groups that have motors on a bus produce a frame on it, which is the minimum
+ * number of frames the DJI protocol allows. A frame whose payload has not changed since it was last sent is held
+ * back until `KEEPALIVE_PERIOD_US` has passed. Bus load is estimated from the frames sent and is
+ * available on the terminal under "cantx".
+ */
+class CanTxScheduler : public tap::communication::serial::TerminalSerialCallbackInterface
+{
+public:
+    static constexpr uint8_t NUM_BUSES = 2;
+    static constexpr uint8_t MOTORS_PER_FRAME = 4;
+    static constexpr uint8_t FRAMES_PER_BUS = 2;
+
+    /// Motor frames with an unchanged payload are resent at least this often.
+    static constexpr uint32_t KEEPALIVE_PERIOD_US = 10'000;
+
+    static constexpr uint32_t BUS_BITRATE = 1'000'000;
+    /// Worst case length of a bit stuffed 8 byte standard frame plus interframe space.
+    static constexpr uint32_t BITS_PER_FRAME = 135;
+    static constexpr uint32_t LOAD_WINDOW_US = 1'000'000;
+
+    CanTxScheduler(Drivers &drivers);
+
+    /**
+     * Registers the "cantx" terminal header.
+     */
+    void init();
+
+    /**
+     * Adds a motor whose desired output should be sent every tick. Call from the owning
+     * subsystem's `initialize`. In hosted builds the motor is also attached to the SocketCAN
+     * bridge, which delivers its feedback.
+     */
+    void addMotor(tap::motor::DjiMotor *motor);
+
+    /**
+     * Sends the motor frames that are due. Call once per control tick.
+     *
+     * @return whether any motor frame was sent, rather than held back as unchanged or failed.
+     */
+    bool sendFrames();
+
+    /**
+     * @return the estimated fraction of the bus bandwidth used over the last `LOAD_WINDOW_US`.
+     */
+    float getBusLoad(tap::can::CanBus bus) const { return buses[busIndex(bus)].load; }
+
+    bool terminalSerialCallback(
+        char *inputLine,
+        modm::IOStream &outputStream,
+        bool streamingEnabled) override;
+
+    void terminalSerialStreamCallback(modm::IOStream &) override {}
+
+private:
+    static constexpr uint32_t FRAME_IDENTIFIERS[FRAMES_PER_BUS] = {0x200, 0x1FF};
+
+    struct MotorFrame
+    {
+        std::array<const tap::motor::DjiMotor *, MOTORS_PER_FRAME> motors{};
+        std::array<uint8_t, 8> lastPayload{};
+        uint32_t lastSentUs{0};
+        bool everSent{false};
+    };
+
+    struct BusState
+    {
+        std::array<MotorFrame, FRAMES_PER_BUS> frames{};
+        uint32_t bitsThisWindow{0};
+        float load{0};
+        uint32_t motorFramesSent{0};
+        uint32_t motorFramesCoalesced{0};
+        uint32_t framesFailed{0};
+    };
+
+    Drivers &drivers;
+
+    std::array<BusState, NUM_BUSES> buses{};
+
+    uint32_t windowStartUs{0};
+
+    static inline uint8_t busIndex(tap::can::CanBus bus)
+    {
+        return bus == tap::can::CanBus::CAN_BUS1 ? 0 : 1;
+    }
+
+    static inline tap::can::CanBus busFromIndex(uint8_t index)
+    {
+        return index == 0 ? tap::can::CanBus::CAN_BUS1 : tap::can::CanBus::CAN_BUS2;
+    }
+
+    bool sendMotorFrames(uint8_t bus, uint32_t now);
+    bool send(uint8_t bus, const modm::can::Message &message);
+    void updateBusLoad(uint32_t now);
+};
+}  // namespace communication::can
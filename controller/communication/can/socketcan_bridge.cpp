@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if defined(PLATFORM_HOSTED) && !defined(ENV_UNIT_TESTS)
+
+#include "socketcan_bridge.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+#include <linux/can.h>
+#include <linux/can/raw.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "tap/communication/can/can_rx_listener.hpp"
+#include "tap/errors/create_errors.hpp"
+
+#include "drivers.hpp"
+
+using tap::can::CanBus;
+
+namespace communication::can
+{
+static inline uint8_t busIndex(CanBus bus) { return bus == CanBus::CAN_BUS1 ? 0 : 1; }
+
+static inline CanBus busFromIndex(uint8_t index)
+{
+    return index == 0 ? CanBus::CAN_BUS1 : CanBus::CAN_BUS2;
+}
+
+SocketCanBridge::SocketCanBridge(Drivers &drivers) : drivers(drivers), sockets{-1, -1} {}
+
+SocketCanBridge::~SocketCanBridge()
+{
+    for (int socket : sockets)
+    {
+        if (socket >= 0)
+        {
+            close(socket);
+        }
+    }
+}
+
+void SocketCanBridge::initialize()
+{
+    const char *can1 = std::getenv("CAN1_INTERFACE");
+    const char *can2 = std::getenv("CAN2_INTERFACE");
+
+    openBus(0, can1 != nullptr ? can1 : DEFAULT_CAN1_INTERFACE);
+    openBus(1, can2 != nullptr ? can2 : DEFAULT_CAN2_INTERFACE);
+}
+
+void SocketCanBridge::openBus(uint8_t bus, const char *interfaceName)
+{
+    int fd = socket(PF_CAN, SOCK_RAW | SOCK_NONBLOCK, CAN_RAW);
+    if (fd < 0)
+    {
+        RAISE_ERROR((&drivers), "socketcan: could not create socket");
+        return;
+    }
+
+    ifreq request{};
+    std::strncpy(request.ifr_name, interfaceName, IFNAMSIZ - 1);
+    if (ioctl(fd, SIOCGIFINDEX, &request) < 0)
+    {
+        RAISE_ERROR((&drivers), "socketcan: interface not found");
+        close(fd);
+        return;
+    }
+
+    sockaddr_can address{};
+    address.can_family = AF_CAN;
+    address.can_ifindex = request.ifr_ifindex;
+    if (bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0)
+    {
+        RAISE_ERROR((&drivers), "socketcan: could not bind interface");
+        close(fd);
+        return;
+    }
+
+    sockets[bus] = fd;
+}
+
+bool SocketCanBridge::attachListener(tap::can::CanRxListener *listener)
+{
+    if (numListeners == MAX_LISTENERS)
+    {
+        return false;
+    }
+
+    listeners[numListeners++] = listener;
+    return true;
+}
+
+bool SocketCanBridge::sendMessage(CanBus bus, const modm::can::Message &message)
+{
+    int fd = sockets[busIndex(bus)];
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    can_frame frame{};
+    frame.can_id = message.getIdentifier();
+    if (message.isExtended())
+    {
+        frame.can_id |= CAN_EFF_FLAG;
+    }
+    if (message.isRemoteTransmitRequest())
+    {
+        frame.can_id |= CAN_RTR_FLAG;
+    }
+    frame.can_dlc = message.getLength();
+    std::memcpy(frame.data, message.data, frame.can_dlc);
+
+    return write(fd, &frame, sizeof(frame)) == sizeof(frame);
+}
+
+bool SocketCanBridge::pollCanData()
+{
+    bool received = false;
+
+    for (uint8_t bus = 0; bus < NUM_BUSES; bus++)
+    {
+        if (sockets[bus] < 0)
+        {
+            continue;
+        }
+
+        can_frame frame;
+        if (read(sockets[bus], &frame, sizeof(frame)) != sizeof(frame))
+        {
+            continue;
+        }
+
+        bool extended = frame.can_id & CAN_EFF_FLAG;
+        modm::can::Message message(
+            frame.can_id & (extended ? CAN_EFF_MASK : CAN_SFF_MASK),
+            frame.can_dlc);
+        message.setExtended(extended);
+        message.setRemoteTransmitRequest(frame.can_id & CAN_RTR_FLAG);
+        std::memcpy(message.data, frame.data, frame.can_dlc);
+
+        dispatch(busFromIndex(bus), message);
+        received = true;
+    }
+
+    return received;
+}
+
+void SocketCanBridge::dispatch(CanBus bus, const modm::can::Message &message)
+{
+    for (uint8_t i = 0; i < numListeners; i++)
+    {
+        tap::can::CanRxListener *listener = listeners[i];
+        if (listener->canBus == bus && listener->canIdentifier == message.getIdentifier())
+        {
+            listener->processMessage(message);
+            return;
+        }
+    }
+}
+}  // namespace communication::can
+
+#endif
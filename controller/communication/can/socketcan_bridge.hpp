@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#if defined(PLATFORM_HOSTED) && !defined(ENV_UNIT_TESTS)
+
+#include <array>
+#include <cstdint>
+
+#include "tap/communication/can/can_bus.hpp"
+
+#include "modm/architecture/interface/can_message.hpp"
+
+class Drivers;
+
+namespace tap::can
+{
+class CanRxListener;
+}
+
+namespace communication::can
+{
+/**
+ * @brief Carries the hosted build's CAN traffic over Linux SocketCAN interfaces.
+ *
+ * The hosted `tap::can::Can` never sends or receives anything, so without this bridge the real
+ * motor encode and decode paths are never exercised off the board. Each bus is mapped to a
+ * SocketCAN interface, by default the virtual interfaces vcan0 and vcan1, on which a simulated
+ * motor process (see testing/motor_sim.py) answers with motor feedback. `CanTxScheduler` sends
+ * through the bridge and `drainReceiveQueue` polls it, so the rest of the firmware is unchanged.
+ *
+ * Frames are dispatched to the listener attached for their bus and identifier, the way
+ * `CanRxHandler` does on the board.
+ */
+class SocketCanBridge
+{
+public:
+    static constexpr uint8_t NUM_BUSES = 2;
+    static constexpr uint8_t MAX_LISTENERS = 16;
+
+    static constexpr const char *DEFAULT_CAN1_INTERFACE = "vcan0";
+    static constexpr const char *DEFAULT_CAN2_INTERFACE = "vcan1";
+
+    SocketCanBridge(Drivers &drivers);
+    ~SocketCanBridge();
+
+    /**
+     * Opens a non-blocking raw CAN socket on each interface. An interface that cannot be opened
+     * raises an error and leaves its bus silent.
+     *
+     * The interface names can be overridden with the `CAN1_INTERFACE` and `CAN2_INTERFACE`
+     * environment variables.
+     */
+    void initialize();
+
+    /**
+     * Routes frames with the listener's bus and identifier to it.
+     *
+     * @return false if the listener table is full.
+     */
+    bool attachListener(tap::can::CanRxListener *listener);
+
+    /**
+     * @return false if the bus is not open or the interface did not accept the frame.
+     */
+    bool sendMessage(tap::can::CanBus bus, const modm::can::Message &message);
+
+    /**
+     * Reads at most one waiting frame from each bus and dispatches it.
+     *
+     * @return false if no bus had a frame waiting.
+     */
+    bool pollCanData();
+
+private:
+    Drivers &drivers;
+
+    std::array<int, NUM_BUSES> sockets;
+
+    std::array<tap::can::CanRxListener *, MAX_LISTENERS> listeners{};
+    uint8_t numListeners{0};
+
+    void openBus(uint8_t bus, const char *interfaceName);
+    void dispatch(tap::can::CanBus bus, const modm::can::Message &message);
+};
+}  // namespace communication::can
+
+#endif
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#if defined(PLATFORM_HOSTED) && !defined(ENV_UNIT_TESTS)
+
+#include <array>
+#include <cstdint>
+
+#include "tap/communication/serial/remote.hpp"
+
+class Drivers;
+
+namespace communication::serial
+{
+/**
+ * @brief Stands in for the DR16 receiver in hosted builds, fed with DR16 frames over UDP.
+ *
+ * Every datagram received on `127.0.0.1:DEFAULT_PORT` (or the port in the `REMOTE_UDP_PORT`
+ * environment variable) is one 18 byte DR16 frame, parsed exactly like the receiver's UART
+ * stream on the board. The accessors mirror `tap::communication::serial::Remote`'s and use its
+ * enums, so the control operator interface reads either one unchanged. testing/remote_bridge.py
+ * produces the frames from a keyboard, a joystick or a script.
+ *
+ * Like the real remote, key and switch changes are forwarded to the command mapper, and all
+ * input is cleared once no frame has arrived for `DISCONNECT_TIMEOUT_US`.
+ */
+class VirtualRemote
+{
+public:
+    using Remote = tap::communication::serial::Remote;
+
+    static constexpr uint16_t DEFAULT_PORT = 7001;
+    static constexpr uint8_t FRAME_LENGTH = 18;
+    static constexpr uint32_t DISCONNECT_TIMEOUT_US = 100'000;
+
+    VirtualRemote(Drivers &drivers);
+    ~VirtualRemote();
+
+    /**
+     * Binds the non-blocking UDP socket frames arrive on. Raises an error if it cannot.
+     */
+    void initialize();
+
+    /**
+     * Parses every frame that has arrived since the last call.
+     */
+    void read();
+
+    bool isConnected() const { return connected; }
+
+    /**
+     * @return the channel's position in [-1, 1].
+     */
+    float getChannel(Remote::Channel channel) const;
+
+    Remote::SwitchState getSwitch(Remote::Switch sw) const;
+
+    int16_t getMouseX() const { return state.mouseX; }
+    int16_t getMouseY() const { return state.mouseY; }
+    int16_t getMouseZ() const { return state.mouseZ; }
+    bool getMouseL() const { return state.mouseL; }
+    bool getMouseR() const { return state.mouseR; }
+
+    bool keyPressed(Remote::Key key) const
+    {
+        return (state.keys & (1 << static_cast<uint8_t>(key))) != 0;
+    }
+
+    /**
+     * @return the number of frames parsed so far.
+     */
+    uint32_t getUpdateCounter() const { return updateCounter; }
+
+private:
+    /// Channel values are offset by this and span +-STICK_MAX_VALUE around it.
+    static constexpr int16_t CHANNEL_CENTER = 1024;
+    static constexpr int16_t STICK_MAX_VALUE = 660;
+
+    struct State
+    {
+        std::array<int16_t, 5> channels{};
+        Remote::SwitchState leftSwitch{Remote::SwitchState::UNKNOWN};
+        Remote::SwitchState rightSwitch{Remote::SwitchState::UNKNOWN};
+        int16_t mouseX{0};
+        int16_t mouseY{0};
+        int16_t mouseZ{0};
+        bool mouseL{false};
+        bool mouseR{false};
+        uint16_t keys{0};
+    };
+
+    Drivers &drivers;
+
+    int socketFd{-1};
+
+    State state{};
+    bool connected{false};
+    uint32_t lastFrameUs{0};
+    uint32_t updateCounter{0};
+
+    void parseFrame(const uint8_t *frame);
+    void reset();
+};
+}  // namespace communication::serial
+
+#endif
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "relay_auto_tuner.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace control::algorithms
+{
+void RelayAutoTuner::start(uint32_t nowUs)
+{
+    state = State::RUNNING;
+    startUs = nowUs;
+    relayHigh = true;
+    cyclesStarted = 0;
+    cycleMaxRpm = config.setpointRpm;
+    cycleMinRpm = config.setpointRpm;
+    periodSumS = 0;
+    amplitudeSumRpm = 0;
+    ultimateGain = 0;
+    ultimatePeriod = 0;
+}
+
+float RelayAutoTuner::update(float measuredRpm, uint32_t nowUs)
+{
+    if (state != State::RUNNING)
+    {
+        return 0;
+    }
+
+    float error = config.setpointRpm - measuredRpm;
+
+    if (std::fabs(error) > config.maxDeviationRpm)
+    {
+        state = State::DIVERGED;
+        return 0;
+    }
+
+    if (nowUs - startUs > config.timeoutUs)
+    {
+        state = State::TIMED_OUT;
+        return 0;
+    }
+
+    cycleMaxRpm = std::max(cycleMaxRpm, measuredRpm);
+    cycleMinRpm = std::min(cycleMinRpm, measuredRpm);
+
+    if (relayHigh && error < -config.hysteresisRpm)
+    {
+        relayHigh = false;
+    }
+    else if (!relayHigh && error > config.hysteresisRpm)
+    {
+        relayHigh = true;
+        finishCycle(nowUs);
+    }
+
+    if (state != State::RUNNING)
+    {
+        return 0;
+    }
+    return config.biasOutput + (relayHigh ? config.relayOutput : -config.relayOutput);
+}
+
+void RelayAutoTuner::finishCycle(uint32_t nowUs)
+{
+    if (cyclesStarted > config.settleCycles)
+    {
+        periodSumS += (nowUs - cycleStartUs) * 1e-6f;
+        amplitudeSumRpm += (cycleMaxRpm - cycleMinRpm) / 2;
+    }
+
+    cyclesStarted++;
+    cycleStartUs = nowUs;
+    cycleMaxRpm = config.setpointRpm;
+    cycleMinRpm = config.setpointRpm;
+
+    if (cyclesStarted <= config.settleCycles + config.measureCycles)
+    {
+        return;
+    }
+
+    float amplitude = amplitudeSumRpm / config.measureCycles;
+    float hysteresis = config.hysteresisRpm;
+    if (amplitude <= hysteresis)
+    {
+        state = State::NO_OSCILLATION;
+        return;
+    }
+
+    ultimatePeriod = periodSumS / config.measureCycles;
+    ultimateGain = 4 * config.relayOutput /
+                   (static_cast<float>(M_PI) *
+                    std::sqrt(amplitude * amplitude - hysteresis * hysteresis));
+    state = State::SUCCEEDED;
+}
+
+PidGains RelayAutoTuner::getGains() const
+{
+    float ku = ultimateGain;
+    float tu = ultimatePeriod;
+
+    switch (config.rule)
+    {
+        case TuningRule::ZIEGLER_NICHOLS_PID:
+            return PidGains{0.6f * ku, 0.6f * ku / (tu / 2), 0.6f * ku * tu / 8};
+        case TuningRule::NO_OVERSHOOT_PID:
+            return PidGains{0.2f * ku, 0.2f * ku / (tu / 2), 0.2f * ku * tu / 3};
+        case TuningRule::ZIEGLER_NICHOLS_PI:
+        default:
+            return PidGains{0.45f * ku, 0.45f * ku / (tu / 1.2f), 0};
+    }
+}
+
+modm::Pid<float>::Parameter toPidParameter(
+    const PidGains &gains,
+    float controlPeriodS,
+    float maxOutput)
+{
+    float ki = gains.ki * controlPeriodS;
+    float kd = gains.kd / controlPeriodS;
+    float maxErrorSum = ki > 0 ? maxOutput / ki : 0;
+    return modm::Pid<float>::Parameter(gains.kp, ki, kd, maxErrorSum, maxOutput);
+}
+
+EduPidConfig toEduPidConfig(const PidGains &gains, float maxOutput)
+{
+    return EduPidConfig{
+        .kp = gains.kp,
+        .ki = gains.ki,
+        .kd = gains.kd,
+        .maxICumulative = maxOutput,
+        .maxOutput = maxOutput,
+    };
+}
+}  // namespace control::algorithms
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "modm/math/filter/pid.hpp"
+
+#include "edu_pid.hpp"
+
+namespace control::algorithms
+{
+/// Rules for turning an ultimate gain and period into PID gains.
+enum class TuningRule : uint8_t
+{
+    ZIEGLER_NICHOLS_PI,   ///< Kp = 0.45 Ku, Ti = Tu / 1.2
+    ZIEGLER_NICHOLS_PID,  ///< Kp = 0.6 Ku, Ti = Tu / 2, Td = Tu / 8
+    NO_OVERSHOOT_PID,     ///< Kp = 0.2 Ku, Ti = Tu / 2, Td = Tu / 3
+};
+
+/// Gains and constants, to be set by the user.
+struct RelayAutoTunerConfig
+{
+    /// Velocity the relay oscillates around, in RPM.
+    const float setpointRpm{0};
+    /// Output added to and subtracted from `biasOutput` by the relay.
+    const float relayOutput{};
+    /// Output held at the setpoint, to overcome friction or gravity.
+    const float biasOutput{0};
+    /// Half width of the relay's dead band, in RPM. Keeps measurement noise from flipping it.
+    const float hysteresisRpm{};
+    /// Oscillation cycles let settle before measuring.
+    const uint8_t settleCycles{3};
+    /// Oscillation cycles averaged into the result.
+    const uint8_t measureCycles{5};
+    /// Tuning fails if it has not finished this long after starting, in microseconds.
+    const uint32_t timeoutUs{20'000'000};
+    /// Tuning fails if the velocity strays further than this from the setpoint, in RPM.
+    const float maxDeviationRpm{};
+    const TuningRule rule{TuningRule::ZIEGLER_NICHOLS_PI};
+    /// Output limit of the PID the tuned gains are applied to.
+    const float maxOutput{};
+};
+
+/// Continuous time PID gains: output = Kp e + Ki integral(e) dt + Kd de/dt.
+struct PidGains
+{
+    float kp;
+    /// Per second.
+    float ki;
+    /// Seconds.
+    float kd;
+};
+
+/**
+ * Relay feedback (Åström-Hägglund) auto tuner for a velocity loop.
+ *
+ * While running, the tuner replaces the loop's controller with a relay: the output is the bias
+ * plus the relay output while the velocity is below the setpoint, minus it while above. The loop
+ * settles into a limit cycle whose period is the ultimate period Tu and whose amplitude a gives
+ * the ultimate gain Ku = 4 d / (pi sqrt(a^2 - h^2)) for relay output d and hysteresis h. Gains
+ * follow from Ku and Tu by the configured rule.
+ *
+ * A cycle runs from one upward switch of the relay to the next.
+ */
+class RelayAutoTuner
+{
+public:
+    enum class State : uint8_t
+    {
+        IDLE,
+        RUNNING,
+        SUCCEEDED,
+        TIMED_OUT,
+        /// The velocity strayed past `maxDeviationRpm`.
+        DIVERGED,
+        /// The limit cycle was too small to tell from the hysteresis.
+        NO_OSCILLATION,
+    };
+
+    RelayAutoTuner(const RelayAutoTunerConfig &config) : config(config) {}
+
+    /**
+     * Starts a new tuning run, forgetting any previous result.
+     */
+    void start(uint32_t nowUs);
+
+    /**
+     * Takes one control step. Call once per control tick while running.
+     *
+     * @param[in] measuredRpm the loop's measured velocity.
+     * @param[in] nowUs the current time, in microseconds.
+     * @return the output to drive the loop with. 0 once the run has ended.
+     */
+    float update(float measuredRpm, uint32_t nowUs);
+
+    State getState() const { return state; }
+
+    bool isRunning() const { return state == State::RUNNING; }
+
+    const RelayAutoTunerConfig &getConfig() const { return config; }
+
+    /// @return the measured ultimate gain, in output per RPM. Valid once SUCCEEDED.
+    float getUltimateGain() const { return ultimateGain; }
+
+    /// @return the measured ultimate period, in seconds. Valid once SUCCEEDED.
+    float getUltimatePeriod() const { return ultimatePeriod; }
+
+    /// @return gains by the configured rule. Valid once SUCCEEDED.
+    PidGains getGains() const;
+
+private:
+    void finishCycle(uint32_t nowUs);
+
+    const RelayAutoTunerConfig &config;
+
+    State state{State::IDLE};
+    uint32_t startUs{0};
+    bool relayHigh{false};
+
+    uint32_t cycleStartUs{0};
+    /// Upward switches seen, the first only starting the first cycle.
+    uint8_t cyclesStarted{0};
+    float cycleMaxRpm{0};
+    float cycleMinRpm{0};
+
+    float periodSumS{0};
+    float amplitudeSumRpm{0};
+
+    float ultimateGain{0};
+    float ultimatePeriod{0};
+};
+
+/**
+ * @return `gains` discretized for a modm::Pid updated every `controlPeriodS` seconds, with the
+ * error sum bounded so the integral term alone can just reach `maxOutput`.
+ */
+modm::Pid<float>::Parameter toPidParameter(
+    const PidGains &gains,
+    float controlPeriodS,
+    float maxOutput);
+
+/**
+ * @return `gains` as an EduPidConfig, which integrates and differentiates over the measured dt
+ * itself, with the integral term bounded by `maxOutput`.
+ */
+EduPidConfig toEduPidConfig(const PidGains &gains, float maxOutput);
+}  // namespace control::algorithms
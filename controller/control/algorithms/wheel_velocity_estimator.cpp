@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "wheel_velocity_estimator.hpp"
+
+namespace control::algorithms
+{
+void WheelVelocityEstimator::update(
+    int64_t encoderUnwrapped,
+    float reportedRpm,
+    uint32_t timestampUs)
+{
+    float reportedVelocity = reportedRpm * config.countsPerRevolution / 60.0f;
+    uint32_t dtUs = timestampUs - lastTimestampUs;
+
+    if (initialized && dtUs == 0)
+    {
+        return;
+    }
+
+    if (!initialized || dtUs > config.maxSampleIntervalUs)
+    {
+        initialized = true;
+        lastTimestampUs = timestampUs;
+        lastEncoder = encoderUnwrapped;
+        positionOffset = 0;
+        velocity = reportedVelocity;
+        return;
+    }
+
+    float dt = dtUs * 1e-6f;
+    float measured = static_cast<float>(encoderUnwrapped - lastEncoder);
+    float predicted = positionOffset + velocity * dt;
+    float residual = measured - predicted;
+
+    positionOffset = predicted + config.alpha * residual - measured;
+    velocity += config.beta * residual / dt;
+    velocity += config.reportedRpmWeight * (reportedVelocity - velocity);
+
+    lastEncoder = encoderUnwrapped;
+    lastTimestampUs = timestampUs;
+}
+}  // namespace control::algorithms
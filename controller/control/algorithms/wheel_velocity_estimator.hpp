@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace control::algorithms
+{
+/// Gains and constants, to be set by the user.
+struct WheelVelocityEstimatorConfig
+{
+    /// Encoder counts per shaft revolution.
+    const float countsPerRevolution{8192};
+    /// Weight of the position residual in the position estimate.
+    const float alpha{0.5f};
+    /// Weight of the position residual in the velocity estimate.
+    const float beta{0.1f};
+    /// Weight of the reported RPM in the velocity estimate.
+    const float reportedRpmWeight{0.05f};
+    /// Gaps in feedback longer than this, in microseconds, reset the filter.
+    const uint32_t maxSampleIntervalUs{20'000};
+};
+
+/**
+ * A fixed cost alpha-beta filter that estimates a wheel's shaft velocity to a fraction of an RPM.
+ *
+ * Each feedback frame, the filter predicts the encoder position from the previous estimate, then
+ * corrects position and velocity by the residual between predicted and measured position. The
+ * integer RPM reported by the motor controller is blended in lightly, which removes the slow drift
+ * a pure position differentiator would have while keeping its quantization out of the estimate.
+ *
+ * Position is kept relative to the last measured encoder count, so precision does not degrade as
+ * the unwrapped encoder value grows.
+ */
+class WheelVelocityEstimator
+{
+public:
+    WheelVelocityEstimator(const WheelVelocityEstimatorConfig &config) : config(config) {}
+
+    /**
+     * Feeds one feedback frame into the filter. Frames with a timestamp that has already been seen
+     * are ignored, so this may be called every control tick.
+     *
+     * @param[in] encoderUnwrapped the unwrapped encoder position, in counts.
+     * @param[in] reportedRpm the shaft RPM reported by the motor controller.
+     * @param[in] timestampUs the time the frame was received, in microseconds.
+     */
+    void update(int64_t encoderUnwrapped, float reportedRpm, uint32_t timestampUs);
+
+    /**
+     * @return the estimated shaft velocity, in RPM.
+     */
+    float getRpm() const { return velocity * 60.0f / config.countsPerRevolution; }
+
+    /**
+     * Forgets all history. The next update reinitializes the filter from its measurement.
+     */
+    void reset() { initialized = false; }
+
+private:
+    const WheelVelocityEstimatorConfig &config;
+
+    bool initialized{false};
+    uint32_t lastTimestampUs{0};
+    int64_t lastEncoder{0};
+    /// Estimated position minus `lastEncoder`, in counts.
+    float positionOffset{0};
+    /// Estimated velocity, in counts per second.
+    float velocity{0};
+};
+}  // namespace control::algorithms
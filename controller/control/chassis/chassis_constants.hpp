@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+namespace control::chassis
+{
+// Drive train constants, kept free of taproot so host tools such as the chassis tuner can share
+// them with ChassisSubsystem.
+
+/// Fastest a wheel motor shaft is commanded to turn, in RPM.
+static constexpr float MAX_WHEELSPEED_RPM = 7000;
+
+/// Motor shaft turns per wheel turn.
+static constexpr float GEAR_RATIO = 19.0f;
+
+static constexpr float WHEEL_DIAMETER_M = 0.076f;
+}  // namespace control::chassis
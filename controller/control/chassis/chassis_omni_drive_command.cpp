@@ -19,22 +19,35 @@
 
 #include "chassis_omni_drive_command.hpp"
 
-#include "tap/algorithms/math_user_utils.hpp"
+#include <algorithm>
 
+#include "architecture/clock.hpp"
 #include "control/control_operator_interface.hpp"
+#include "control/remote_failsafe.hpp"
+#include "diagnostics/latency_tracer.hpp"
+#include "diagnostics/scheduler_costs.hpp"
 
 #include "chassis_subsystem.hpp"
 
-using tap::algorithms::limitVal;
-
 namespace control::chassis
 {
 // STEP 1 (Tank Drive): Constructor
 ChassisOmniDriveCommand::ChassisOmniDriveCommand(
     ChassisSubsystem &chassis,
-    ControlOperatorInterface &operatorInterface)
+    ControlOperatorInterface &operatorInterface,
+    diagnostics::LatencyTracer &latencyTracer,
+    RemoteFailsafe &remoteFailsafe,
+    diagnostics::SchedulerCosts &schedulerCosts)
     : chassis(chassis),
-      operatorInterface(operatorInterface)
+      operatorInterface(operatorInterface),
+      latencyTracer(latencyTracer),
+      remoteFailsafe(remoteFailsafe),
+      schedulerCosts(schedulerCosts),
+      maxSpeedMps(std::min(
+          {MAX_CHASSIS_SPEED_MPS,
+           chassis.getMaxScaleAlong(Twist{1, 0, 0}),
+           chassis.getMaxScaleAlong(Twist{0, 1, 0})})),
+      maxYawRate(std::min(MAX_CHASSIS_YAW_RATE, chassis.getMaxScaleAlong(Twist{0, 0, 1})))
 {
     addSubsystemRequirement(&chassis);
 }
@@ -42,18 +55,23 @@ ChassisOmniDriveCommand::ChassisOmniDriveCommand(
 // STEP 2 (Tank Drive): execute function
 void ChassisOmniDriveCommand::execute()
 {
-    auto scale = [](float raw) -> float {
-        return limitVal(raw, -1.0f, 1.0f) * MAX_CHASSIS_SPEED_MPS;
-    };
-
-    chassis.setVelocityOmniDrive(
-        scale(operatorInterface.getChassisOmniLeftFrontInput()),
-        scale(operatorInterface.getChassisOmniLeftBackInput()),
-        scale(operatorInterface.getChassisOmniRightFrontInput()),
-        scale(operatorInterface.getChassisOmniRightBackInput())
-    );
+    SCHEDULER_COST_SCOPE(schedulerCosts);
+
+    float failsafeScale = remoteFailsafe.update(architecture::clock::getTimeMicroseconds());
+
+    Twist stick = operatorInterface.getChassisStickInput();
+
+    chassis.setDesiredTwist(Twist{
+        stick.x * maxSpeedMps * failsafeScale,
+        stick.y * maxSpeedMps * failsafeScale,
+        stick.z * maxYawRate * failsafeScale});
+
+    latencyTracer.stampInput(
+        diagnostics::LatencyInput::REMOTE,
+        operatorInterface.getRemoteFrameTime());
+    latencyTracer.stampInput(diagnostics::LatencyInput::IMU, operatorInterface.getImuSampleTime());
 }
 
 // STEP 3 (Tank Drive): end function
-void ChassisOmniDriveCommand::end(bool) { chassis.setVelocityOmniDrive(.0f, .0f, .0f, .0f); }
+void ChassisOmniDriveCommand::end(bool) { chassis.setDesiredTwist(Twist{0, 0, 0}); }
 };  // namespace control::chassis
@@ -24,6 +24,13 @@
 namespace control
 {
 class ControlOperatorInterface;
+class RemoteFailsafe;
+}
+
+namespace diagnostics
+{
+class LatencyTracer;
+class SchedulerCosts;
 }
 
 namespace control::chassis
@@ -38,14 +45,26 @@ class ChassisSubsystem;
 class ChassisOmniDriveCommand : public tap::control::Command
 {
 public:
+    /// Speed commanded by a full stick, in m/s, unless the chassis cannot reach it.
     static constexpr float MAX_CHASSIS_SPEED_MPS = 3.0f;
 
+    /// Yaw rate commanded by a full stick, in rad/s, unless the chassis cannot reach it.
+    static constexpr float MAX_CHASSIS_YAW_RATE = 6.0f;
+
     /**
      * @brief Construct a new Chassis Tank Drive Command object
      *
      * @param chassis Chassis to control.
+     * @param latencyTracer Tracer to stamp with the age of the inputs used each tick.
+     * @param remoteFailsafe Failsafe that ramps the command to zero if the remote link drops.
+     * @param schedulerCosts Accounts and traces the cost of each execute.
      */
-    ChassisOmniDriveCommand(ChassisSubsystem &chassis, ControlOperatorInterface &operatorInterface);
+    ChassisOmniDriveCommand(
+        ChassisSubsystem &chassis,
+        ControlOperatorInterface &operatorInterface,
+        diagnostics::LatencyTracer &latencyTracer,
+        RemoteFailsafe &remoteFailsafe,
+        diagnostics::SchedulerCosts &schedulerCosts);
 
     const char *getName() const override { return "Chassis omni drive"; }
 
@@ -61,5 +80,17 @@ private:
     ChassisSubsystem &chassis;
 
     ControlOperatorInterface &operatorInterface;
+
+    diagnostics::LatencyTracer &latencyTracer;
+
+    RemoteFailsafe &remoteFailsafe;
+
+    diagnostics::SchedulerCosts &schedulerCosts;
+
+    /// Linear speed of a full stick, in m/s, capped to what the chassis can reach.
+    const float maxSpeedMps;
+
+    /// Yaw rate of a full stick, in rad/s, capped to what the chassis can reach.
+    const float maxYawRate;
 };
 }  // namespace control::chassis
\ No newline at end of file
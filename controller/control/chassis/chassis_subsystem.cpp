@@ -19,7 +19,14 @@
 
 #include "chassis_subsystem.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 #include "tap/algorithms/math_user_utils.hpp"
+#include "tap/errors/create_errors.hpp"
+
+#include "architecture/clock.hpp"
+#include "diagnostics/scheduler_costs.hpp"
 
 #include "drivers.hpp"
 
@@ -27,11 +34,69 @@ using tap::algorithms::limitVal;
 
 namespace control::chassis
 {
+namespace
+{
+// The folded twist to RPM transform, checked at compile time against wheel RPMs worked out by
+// hand for a 0.4 m square chassis. Each wheel turns at (vx -+ vy -+ 0.4 z) / r rad/s, with the
+// signs of the LF, LB, RF and RB rollers, and its shaft at 60 / 2pi * GEAR_RATIO RPM per rad/s.
+constexpr ChassisSubsystem::Kinematics CHECKED_KINEMATICS{makeMecanumGeometry(
+    0.4f,
+    0.4f,
+    WHEEL_DIAMETER_M / 2,
+    GEAR_RATIO)};
+constexpr TwistToRpmTransform CHECKED_TRANSFORM{
+    CHECKED_KINEMATICS,
+    CHECKED_KINEMATICS.getShaftRpmPerWheelRadPerSec(),
+    MAX_WHEELSPEED_RPM};
+constexpr Twist CHECKED_TWIST{1.0f, 0.5f, 2.0f};
+
+constexpr bool isNearRpm(float rpm, float expected)
+{
+    return rpm - expected < 0.5f && expected - rpm < 0.5f;
+}
+
+static_assert(isNearRpm(CHECKED_TRANSFORM.applyUnsaturated(CHECKED_TWIST)[0], -1432.39f));
+static_assert(isNearRpm(CHECKED_TRANSFORM.applyUnsaturated(CHECKED_TWIST)[1], 3342.25f));
+static_assert(isNearRpm(CHECKED_TRANSFORM.applyUnsaturated(CHECKED_TWIST)[2], 10981.69f));
+static_assert(isNearRpm(CHECKED_TRANSFORM.applyUnsaturated(CHECKED_TWIST)[3], 6207.04f));
+// RF needs the most, so every wheel is scaled by 7000 / 10981.69
+static_assert(isNearRpm(CHECKED_TRANSFORM.apply(CHECKED_TWIST)[0], -913.04f));
+static_assert(isNearRpm(CHECKED_TRANSFORM.apply(CHECKED_TWIST)[1], 2130.43f));
+static_assert(isNearRpm(CHECKED_TRANSFORM.apply(CHECKED_TWIST)[2], 7000.0f));
+static_assert(isNearRpm(CHECKED_TRANSFORM.apply(CHECKED_TWIST)[3], 3956.52f));
+}  // namespace
+
 // STEP 1 (Tank Drive): create constructor
 ChassisSubsystem::ChassisSubsystem(Drivers &drivers, const ChassisConfig &config)
     : tap::control::Subsystem(&drivers),
+      motorTimeoutUs(config.motorTimeoutUs),
+      wheelVelocityFeedforward(config.wheelVelocityFeedforward),
+      setpointSlewRpmPerSec(config.setpointSlewRpmPerSec),
+      kinematics(makeMecanumGeometry(
+          config.wheelBaseM,
+          config.trackWidthM,
+          WHEEL_DIAMETER_M / 2,
+          GEAR_RATIO)),
+      twistToRpm(kinematics, kinematics.getShaftRpmPerWheelRadPerSec(), MAX_WHEELSPEED_RPM),
+      motorOnline{},
+      numMotorsOnline(0),
+      desiredTwist{},
       desiredOutput{},
+      slewedSetpoints{},
+      lastRefreshUs(0),
+      hasRefreshed(false),
+      feedbackAge{},
+      velocityEstimators{
+          algorithms::WheelVelocityEstimator(WHEEL_VELOCITY_ESTIMATOR_CONFIG),
+          algorithms::WheelVelocityEstimator(WHEEL_VELOCITY_ESTIMATOR_CONFIG),
+          algorithms::WheelVelocityEstimator(WHEEL_VELOCITY_ESTIMATOR_CONFIG),
+          algorithms::WheelVelocityEstimator(WHEEL_VELOCITY_ESTIMATOR_CONFIG),
+      },
+      tractionController(TRACTION_CONTROL_CONFIG, kinematics),
       pidControllers{},
+      tunedWheel(static_cast<uint8_t>(MotorId::LF)),
+      tuningActive(false),
+      tuningOutput(0),
       motors{
           Motor(&drivers, config.leftFrontId, config.canBus, false, "LF"),
           Motor(&drivers, config.leftBackId, config.canBus, false, "LB"),
@@ -39,10 +104,7 @@ ChassisSubsystem::ChassisSubsystem(Drivers &drivers, const ChassisConfig &config
           Motor(&drivers, config.rightBackId, config.canBus, true, "RB")
       }
 {
-    for (auto &controller : pidControllers)
-    {
-        controller.setParameter(config.wheelVelocityPidConfig);
-    }
+    setVelocityPidParameter(config.wheelVelocityPidConfig);
 }
 
 // STEP 2 (Tank Drive): initialize function
@@ -51,42 +113,182 @@ void ChassisSubsystem::initialize()
     for (auto &motor : motors)
     {
         motor.initialize();
+        getDrivers().canTxScheduler.addMotor(&motor);
     }
 }
 
-// STEP 4 (Tank Drive): setVelocityOmniDrive function
-void ChassisSubsystem::setVelocityOmniDrive(float leftFront,
-                                            float leftBack,
-                                            float rightFront,
-                                            float rightBack)
+// STEP 5 (Tank Drive): refresh function
+void ChassisSubsystem::refresh()
 {
-    leftFront  = mpsToRpm(leftFront);
-    leftBack   = mpsToRpm(leftBack);
-    rightFront = mpsToRpm(rightFront);
-    rightBack  = mpsToRpm(rightBack);
-
-    leftFront  = limitVal(leftFront, -MAX_WHEELSPEED_RPM, MAX_WHEELSPEED_RPM);
-    leftBack   = limitVal(leftBack, -MAX_WHEELSPEED_RPM, MAX_WHEELSPEED_RPM);
-    rightFront = limitVal(rightFront, -MAX_WHEELSPEED_RPM, MAX_WHEELSPEED_RPM);
-    rightBack  = limitVal(rightBack, -MAX_WHEELSPEED_RPM, MAX_WHEELSPEED_RPM);
-
-    desiredOutput[static_cast<uint8_t>(MotorId::LF)] = leftFront;
-    desiredOutput[static_cast<uint8_t>(MotorId::LB)] = leftBack;
-    desiredOutput[static_cast<uint8_t>(MotorId::RF)] = rightFront;
-    desiredOutput[static_cast<uint8_t>(MotorId::RB)] = rightBack;
+    SCHEDULER_COST_SCOPE(getDrivers().schedulerCosts);
+
+    auto runPid =
+        [this](Pid &pid, Motor &motor, float measuredRpm, float desiredOutput, float torqueScale) {
+            pid.update(desiredOutput - measuredRpm);
+            float output = pid.getValue() + wheelVelocityFeedforward * desiredOutput;
+            motor.setDesiredOutput(output * torqueScale);
+        };
+
+    uint32_t now = architecture::clock::getTimeMicroseconds();
+    // The first refresh only seeds the period, so slewing starts from rest instead of jumping
+    uint32_t dtUs = hasRefreshed ? now - lastRefreshUs : 0;
+    lastRefreshUs = now;
+    hasRefreshed = true;
+
+    uint32_t oldestFeedbackAge = 0;
+    float maxAbsWheelRpm = 0;
+
+    for (size_t ii = 0; ii < motors.size(); ii++)
+    {
+        feedbackAge[ii] = motors[ii].getFeedbackAge(now);
+        if (feedbackAge[ii] <= motorTimeoutUs)
+        {
+            oldestFeedbackAge = std::max(oldestFeedbackAge, feedbackAge[ii]);
+        }
+
+        velocityEstimators[ii].update(
+            motors[ii].getEncoderUnwrapped(),
+            motors[ii].getShaftRPM(),
+            motors[ii].getLastFeedbackTime());
+        maxAbsWheelRpm = std::max(maxAbsWheelRpm, std::fabs(velocityEstimators[ii].getRpm()));
+    }
+
+    updateMotorOnline();
+
+    std::array<float, NUM_WHEELS> measuredRpm;
+    Kinematics::WheelSpeeds measuredWheelSpeeds;
+    for (uint8_t ii = 0; ii < NUM_WHEELS; ii++)
+    {
+        measuredRpm[ii] = velocityEstimators[ii].getRpm();
+        measuredWheelSpeeds[ii] = rpmToWheelRadPerSec(measuredRpm[ii]);
+    }
+
+    const imu::OrientationSample &imuSample = getDrivers().imuPipeline.getLatestSample();
+    tractionController.update(
+        measuredWheelSpeeds,
+        ImuMotion{
+            .accelX = imuSample.accelX,
+            .accelY = imuSample.accelY,
+            .yawRate = modm::toRadian(imuSample.yawRate),
+        },
+        dtUs,
+        numMotorsOnline == NUM_WHEELS);
+
+    std::array<float, NUM_WHEELS> setpoints =
+        isDegraded() ? solveDegradedSetpoints() : desiredOutput;
+    bool canDrive = numMotorsOnline >= NUM_WHEELS - 1;
+
+    if (tuningActive)
+    {
+        setpoints.fill(0);
+    }
+
+    slewSetpoints(setpoints, dtUs);
+
+    for (size_t ii = 0; ii < motors.size(); ii++)
+    {
+        if (!canDrive || !motorOnline[ii])
+        {
+            pidControllers[ii].reset();
+            slewedSetpoints[ii] = 0;
+            motors[ii].setDesiredOutput(0);
+            continue;
+        }
+
+        if (tuningActive && ii == tunedWheel)
+        {
+            pidControllers[ii].reset();
+            slewedSetpoints[ii] = 0;
+            motors[ii].setDesiredOutput(tuningOutput);
+            continue;
+        }
+
+        runPid(
+            pidControllers[ii],
+            motors[ii],
+            measuredRpm[ii],
+            slewedSetpoints[ii],
+            tractionController.getTorqueScale(ii));
+    }
+
+    getDrivers().imuPipeline.setMaxWheelSpeed(maxAbsWheelRpm);
+    getDrivers().latencyTracer.stampInput(
+        diagnostics::LatencyInput::MOTOR_FEEDBACK,
+        now - oldestFeedbackAge);
 }
 
-// STEP 5 (Tank Drive): refresh function
-void ChassisSubsystem::refresh()
+Drivers &ChassisSubsystem::getDrivers() const
 {
-    auto runPid = [](Pid &pid, Motor &motor, float desiredOutput) {
-        pid.update(desiredOutput - motor.getShaftRPM());
-        motor.setDesiredOutput(pid.getValue());
-    };
+    return *static_cast<Drivers *>(drivers);
+}
+
+void ChassisSubsystem::setVelocityPidParameter(const Pid::Parameter &parameter)
+{
+    for (auto &controller : pidControllers)
+    {
+        controller.setParameter(parameter);
+    }
+}
+
+void ChassisSubsystem::updateMotorOnline()
+{
+    numMotorsOnline = 0;
 
     for (size_t ii = 0; ii < motors.size(); ii++)
     {
-        runPid(pidControllers[ii], motors[ii], desiredOutput[ii]);
+        bool online = feedbackAge[ii] <= motorTimeoutUs;
+
+        if (motorOnline[ii] && !online)
+        {
+            RAISE_ERROR((&getDrivers()), "chassis motor feedback timed out");
+        }
+
+        motorOnline[ii] = online;
+        numMotorsOnline += online;
+    }
+}
+
+std::array<float, ChassisSubsystem::NUM_WHEELS> ChassisSubsystem::solveDegradedSetpoints() const
+{
+    TwistToRpmTransform::WheelRpm resolved = twistToRpm.applyUnsaturated(desiredTwist);
+
+    std::array<float, NUM_WHEELS> setpoints{};
+    float maxAbsSetpoint = 0;
+    for (uint8_t ii = 0; ii < NUM_WHEELS; ii++)
+    {
+        if (motorOnline[ii])
+        {
+            setpoints[ii] = resolved[ii];
+            maxAbsSetpoint = std::max(maxAbsSetpoint, std::fabs(setpoints[ii]));
+        }
+    }
+
+    // Scale the online wheels together rather than clamping each, so the twist keeps its direction
+    if (maxAbsSetpoint > MAX_WHEELSPEED_RPM)
+    {
+        for (auto &setpoint : setpoints)
+        {
+            setpoint *= MAX_WHEELSPEED_RPM / maxAbsSetpoint;
+        }
+    }
+
+    return setpoints;
+}
+
+void ChassisSubsystem::slewSetpoints(
+    const std::array<float, NUM_WHEELS> &setpoints,
+    uint32_t dtUs)
+{
+    if (setpointSlewRpmPerSec <= 0)
+    {
+        slewedSetpoints = setpoints;
+        return;
+    }
+
+    float maxStep = setpointSlewRpmPerSec * dtUs / 1e6f;
+    for (uint8_t ii = 0; ii < NUM_WHEELS; ii++)
+    {
+        slewedSetpoints[ii] += limitVal(setpoints[ii] - slewedSetpoints[ii], -maxStep, maxStep);
     }
 }
 }  // namespace control::chassis
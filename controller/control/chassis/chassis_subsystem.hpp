@@ -20,6 +20,7 @@
 #pragma once
 
 #include <array>
+#include <cmath>
 
 #include "tap/control/subsystem.hpp"
 #include "tap/util_macros.hpp"
@@ -27,11 +28,15 @@
 #include "modm/math/filter/pid.hpp"
 #include "modm/math/geometry/angle.hpp"
 
-#if defined(PLATFORM_HOSTED) && defined(ENV_UNIT_TESTS)
-#include "tap/mock/dji_motor_mock.hpp"
-#else
-#include "tap/motor/dji_motor.hpp"
-#endif
+#include "control/algorithms/relay_auto_tuner.hpp"
+#include "control/algorithms/wheel_velocity_estimator.hpp"
+#include "control/motor/timestamped_dji_motor.hpp"
+#include "control/tuning/tunable_velocity_loop.hpp"
+
+#include "chassis_constants.hpp"
+#include "chassis_kinematics.hpp"
+#include "traction_controller.hpp"
+#include "twist_to_rpm_transform.hpp"
 
 class Drivers;
 
@@ -45,12 +50,34 @@ struct ChassisConfig
     tap::motor::MotorId rightFrontId;
     tap::can::CanBus canBus;
     modm::Pid<float>::Parameter wheelVelocityPidConfig;
+    /// A motor whose feedback is older than this, in microseconds, is considered offline.
+    uint32_t motorTimeoutUs;
+    /// Distance between the front and back axles, in m.
+    float wheelBaseM;
+    /// Distance between the left and right wheels, in m.
+    float trackWidthM;
+    /// Motor output added per RPM of wheel setpoint, ahead of the velocity PID.
+    float wheelVelocityFeedforward;
+    /// Fastest a wheel setpoint may change, in RPM per second. 0 leaves setpoints unlimited.
+    float setpointSlewRpmPerSec;
 };
 
 ///
 /// @brief This subsystem encapsulates four motors that control the chassis.
 ///
-class ChassisSubsystem : public tap::control::Subsystem
+/// Each refresh, every motor whose feedback is older than the configured timeout is treated as
+/// offline: it is commanded zero output and its PID is reset. With one motor offline the chassis
+/// keeps driving on the remaining three, whose setpoints are solved from the desired body twist
+/// using only their own rows of the inverse kinematics, leaving the offline wheel to roll freely.
+/// With more than one offline the chassis stops.
+///
+/// While all four motors are online, a TractionController checks each wheel against a reference
+/// twist from the IMU and cuts the torque of every wheel that slips.
+///
+/// One wheel at a time can be handed to a tuning command, which drives it open loop while the
+/// other wheels are held at rest. All four wheels share the tuned PID parameters.
+///
+class ChassisSubsystem : public tap::control::Subsystem, public tuning::TunableVelocityLoop
 {
 public:
     /// @brief Motor ID to index into the velocityPid and motors object.
@@ -66,12 +93,30 @@ public:
     using Pid = modm::Pid<float>;
 
 #if defined(PLATFORM_HOSTED) && defined(ENV_UNIT_TESTS)
-    using Motor = testing::NiceMock<tap::mock::DjiMotorMock>;
+    using Motor = testing::NiceMock<motor::TimestampedDjiMotor>;
 #else
-    using Motor = tap::motor::DjiMotor;
+    using Motor = motor::TimestampedDjiMotor;
 #endif
 
-    static constexpr float MAX_WHEELSPEED_RPM = 7000;
+    static constexpr algorithms::WheelVelocityEstimatorConfig WHEEL_VELOCITY_ESTIMATOR_CONFIG{};
+
+    static constexpr TractionControlConfig TRACTION_CONTROL_CONFIG{};
+
+    /// Relay auto-tune of a wheel, swinging it by about +-3.7 A around rest.
+    static constexpr algorithms::RelayAutoTunerConfig WHEEL_AUTO_TUNE_CONFIG{
+        .setpointRpm = 0,
+        .relayOutput = 3'000,
+        .biasOutput = 0,
+        .hysteresisRpm = 50,
+        .settleCycles = 3,
+        .measureCycles = 5,
+        .timeoutUs = 20'000'000,
+        .maxDeviationRpm = 4'000,
+        .rule = algorithms::TuningRule::ZIEGLER_NICHOLS_PI,
+        .maxOutput = 16'000,
+    };
+
+    using Kinematics = ChassisKinematics<static_cast<uint8_t>(MotorId::NUM_MOTORS)>;
 
     ChassisSubsystem(Drivers& drivers, const ChassisConfig& config);
 
@@ -81,20 +126,26 @@ public:
     void initialize() override;
 
     ///
-    /// @brief Control the chassis using omni drive. Sets the wheel velocity of the four drive
-    /// motors individually based on on the input left/right desired velocity.
+    /// @brief Drives the chassis at a body twist. If a wheel would need more than
+    /// `MAX_WHEELSPEED_RPM` all wheels are slowed down together, keeping the twist's direction.
     ///
-    /// @param leftFront Desired speed in m/s of the left-front wheel of the chassis. Positive speed is
-    /// forward, negative is backwards.
-    /// @param leftBack Desired speed in m/s of the left-back wheel of the chassis. Positive speed is
-    /// forward, negative is backwards.
-    /// @param rightFront Desired chassis speed in m/s of the right-front of the chassis. Positive speed is
-    /// forward, negative is backwards.
-    /// @param rightBack Desired speed in m/s of the right-back wheel of the chassis. Positive speed is
-    /// forward, negative is backwards.
+    /// @param twist x forward and y left in m/s, z counter-clockwise in rad/s.
     ///
-    void setVelocityOmniDrive(float leftFront, float leftBack, float rightFront, float rightBack);
-    
+    void setDesiredTwist(const Twist& twist)
+    {
+        desiredTwist = twist;
+        desiredOutput = twistToRpm.apply(twist);
+    }
+
+    ///
+    /// @return The largest multiple of `direction` the chassis can drive at without a wheel
+    /// exceeding `MAX_WHEELSPEED_RPM`. For a unit twist this is the top speed along it.
+    ///
+    float getMaxScaleAlong(const Twist& direction) const
+    {
+        return twistToRpm.getMaxScaleAlong(direction);
+    }
+
     ///
     /// @brief Runs velocity PID controllers for the drive motors.
     ///
@@ -102,23 +153,150 @@ public:
 
     const char* getName() override { return "Chassis"; }
 
-private:
-    inline float mpsToRpm(float mps)
+    ///
+    /// @return Microseconds between the feedback frame used by the last `refresh` being received
+    /// and that `refresh` running.
+    ///
+    uint32_t getFeedbackAge(MotorId motorId) const
     {
-        static constexpr float GEAR_RATIO = 19.0f;
-        static constexpr float WHEEL_DIAMETER_M = 0.076f;
-        static constexpr float WHEEL_CIRCUMFERANCE_M = M_PI * WHEEL_DIAMETER_M;
-        static constexpr float SEC_PER_M = 60.0f;
+        return feedbackAge[static_cast<uint8_t>(motorId)];
+    }
+
+    ///
+    /// @return The motor driving the given wheel.
+    ///
+    const Motor& getMotor(MotorId motorId) const { return motors[static_cast<uint8_t>(motorId)]; }
 
-        return (mps / WHEEL_CIRCUMFERANCE_M) * SEC_PER_M * GEAR_RATIO;
+    ///
+    /// @return Whether the motor's feedback was fresh as of the last `refresh`.
+    ///
+    bool isMotorOnline(MotorId motorId) const
+    {
+        return motorOnline[static_cast<uint8_t>(motorId)];
+    }
+
+    ///
+    /// @return Whether the chassis is driving on three wheels.
+    ///
+    bool isDegraded() const { return numMotorsOnline == NUM_WHEELS - 1; }
+
+    ///
+    /// @return Shaft RPM setpoint the wheel's PID ran on in the last `refresh`, after the degraded
+    /// mode solve and slew limiting.
+    ///
+    float getSetpointRpm(MotorId motorId) const
+    {
+        return slewedSetpoints[static_cast<uint8_t>(motorId)];
+    }
+
+    ///
+    /// @return Estimated shaft RPM of the wheel as of the last `refresh`.
+    ///
+    float getWheelRpm(MotorId motorId) const
+    {
+        return velocityEstimators[static_cast<uint8_t>(motorId)].getRpm();
     }
 
+    ///
+    /// @brief Selects the wheel a tuning command drives. Takes effect on the next
+    /// `setTuningOutput`.
+    ///
+    void setTunedWheel(MotorId motorId) { tunedWheel = static_cast<uint8_t>(motorId); }
+
+    tap::control::Subsystem& getTunedSubsystem() override { return *this; }
+
+    float getTunedVelocityRpm() const override
+    {
+        return velocityEstimators[tunedWheel].getRpm();
+    }
+
+    bool isTunedMotorOnline() const override { return motorOnline[tunedWheel]; }
+
+    void setTuningOutput(float output) override
+    {
+        tuningActive = true;
+        tuningOutput = output;
+    }
+
+    void clearTuningOutput() override { tuningActive = false; }
+
+    void setVelocityPidParameter(const Pid::Parameter& parameter) override;
+
+private:
+    static constexpr uint8_t NUM_WHEELS = static_cast<uint8_t>(MotorId::NUM_MOTORS);
+
+    ///
+    /// @brief Updates which motors are online from their feedback age, raising an error for every
+    /// motor that has just dropped out.
+    ///
+    void updateMotorOnline();
+
+    ///
+    /// @return Setpoints for the online wheels that produce `desiredTwist`, scaled down together
+    /// so none exceeds `MAX_WHEELSPEED_RPM`. Three mecanum wheels are exactly determined, so each
+    /// online wheel takes its own row of the inverse kinematics and the offline wheel gets 0.
+    ///
+    std::array<float, NUM_WHEELS> solveDegradedSetpoints() const;
+
+    ///
+    /// @brief Moves `slewedSetpoints` towards `setpoints` by at most `setpointSlewRpmPerSec`
+    /// over `dtUs`.
+    ///
+    void slewSetpoints(const std::array<float, NUM_WHEELS> &setpoints, uint32_t dtUs);
+
+    inline float rpmToWheelRadPerSec(float rpm) const
+    {
+        return rpm / kinematics.getShaftRpmPerWheelRadPerSec();
+    }
+
+    ///
+    /// @return The drivers passed to the constructor, which `Subsystem` keeps as `tap::Drivers`.
+    ///
+    Drivers& getDrivers() const;
+
+    const uint32_t motorTimeoutUs;
+
+    const float wheelVelocityFeedforward;
+    const float setpointSlewRpmPerSec;
+
+    /// Built from the configured wheel base and track width.
+    const Kinematics kinematics;
+
+    /// Body twist to shaft RPM, with the wheel conversion and speed limit folded in.
+    const TwistToRpmTransform twistToRpm;
+
+    std::array<bool, NUM_WHEELS> motorOnline;
+    uint8_t numMotorsOnline;
+
+    /// Body twist the desired wheel outputs were set from.
+    Twist desiredTwist;
+
     /// Desired wheel output for each motor
     std::array<float, static_cast<uint8_t>(MotorId::NUM_MOTORS)> desiredOutput;
 
+    /// Setpoints the PIDs ran on last refresh, after slew limiting.
+    std::array<float, static_cast<uint8_t>(MotorId::NUM_MOTORS)> slewedSetpoints;
+    uint32_t lastRefreshUs;
+    /// False until the first refresh, which has no previous one to measure its period from.
+    bool hasRefreshed;
+
+    /// Age of each motor's feedback as of the last refresh, in microseconds.
+    std::array<uint32_t, static_cast<uint8_t>(MotorId::NUM_MOTORS)> feedbackAge;
+
+    /// Shaft velocity estimators, fed from each motor's encoder and reported RPM.
+    std::array<algorithms::WheelVelocityEstimator, static_cast<uint8_t>(MotorId::NUM_MOTORS)>
+        velocityEstimators;
+
+    TractionController tractionController;
+
     /// PID controllers. Input desired wheel velocity, output desired motor current.
     std::array<Pid, static_cast<uint8_t>(MotorId::NUM_MOTORS)> pidControllers;
 
+    /// Wheel driven by `tuningOutput` instead of its PID while `tuningActive`.
+    uint8_t tunedWheel;
+    bool tuningActive;
+    float tuningOutput;
+
 protected:
     /// Motors.
     std::array<Motor, static_cast<uint8_t>(MotorId::NUM_MOTORS)> motors;
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "traction_controller.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "tap/algorithms/math_user_utils.hpp"
+
+using tap::algorithms::limitVal;
+
+namespace control::chassis
+{
+TractionController::TractionController(
+    const TractionControlConfig &config,
+    const Kinematics &kinematics)
+    : config(config),
+      kinematics(kinematics),
+      reference{},
+      lastFit{},
+      referenceValid(false),
+      coastUs(0),
+      slip{},
+      torqueScale{}
+{
+    torqueScale.fill(1.0f);
+}
+
+void TractionController::update(
+    const Kinematics::WheelSpeeds &wheelSpeeds,
+    const ImuMotion &imu,
+    uint32_t dtUs,
+    bool enabled)
+{
+    slip.fill(0.0f);
+
+    if (!enabled)
+    {
+        referenceValid = false;
+        for (float &scale : torqueScale)
+        {
+            scale += config.torqueScaleAlpha * (1.0f - scale);
+        }
+        return;
+    }
+
+    Twist fit = kinematics.toTwist(wheelSpeeds);
+    Kinematics::WheelSpeeds fitSpeeds = kinematics.toWheelSpeeds(fit);
+    float fitResidual = 0.0f;
+    for (uint8_t wheel = 0; wheel < NUM_WHEELS; wheel++)
+    {
+        fitResidual = std::max(
+            fitResidual,
+            std::fabs(wheelSpeeds[wheel] - fitSpeeds[wheel]) /
+                std::max(std::fabs(fitSpeeds[wheel]), config.minReferenceSpeed));
+    }
+
+    updateReference(fit, fitResidual, imu, dtUs);
+
+    Kinematics::WheelSpeeds implied = kinematics.toWheelSpeeds(reference);
+    for (uint8_t wheel = 0; wheel < NUM_WHEELS; wheel++)
+    {
+        slip[wheel] = std::fabs(wheelSpeeds[wheel] - implied[wheel]) /
+                      std::max(std::fabs(implied[wheel]), config.minReferenceSpeed);
+
+        float targetScale = 1.0f;
+        if (slip[wheel] > config.slipThreshold)
+        {
+            targetScale = limitVal(
+                1.0f - config.torqueCutGain * (slip[wheel] - config.slipThreshold),
+                config.minTorqueScale,
+                1.0f);
+        }
+
+        torqueScale[wheel] += config.torqueScaleAlpha * (targetScale - torqueScale[wheel]);
+    }
+}
+
+void TractionController::updateReference(
+    const Twist &fit,
+    float fitResidual,
+    const ImuMotion &imu,
+    uint32_t dtUs)
+{
+    reference.z = imu.yawRate;
+
+    // First update, or too long since the last one to integrate across
+    if (!referenceValid || dtUs > config.maxCoastUs || dtUs == 0)
+    {
+        reference.x = fit.x;
+        reference.y = fit.y;
+        lastFit = fit;
+        referenceValid = true;
+        coastUs = 0;
+        return;
+    }
+
+    // Velocity in the rotating chassis frame: dv/dt = a - omega x v
+    float dt = dtUs * 1e-6f;
+    float vx = reference.x;
+    float vy = reference.y;
+    float accelX = imu.accelX + imu.yawRate * vy;
+    float accelY = imu.accelY - imu.yawRate * vx;
+    reference.x += accelX * dt;
+    reference.y += accelY * dt;
+
+    bool fitAccelMatches = std::hypot(
+                               (fit.x - lastFit.x) / dt - accelX,
+                               (fit.y - lastFit.y) / dt - accelY) <= config.maxAccelMismatch;
+    lastFit = fit;
+
+    if (fitResidual <= config.maxFitResidual && fitAccelMatches)
+    {
+        reference.x += config.wheelCorrectionGain * (fit.x - reference.x);
+        reference.y += config.wheelCorrectionGain * (fit.y - reference.y);
+        coastUs = 0;
+        return;
+    }
+
+    coastUs += dtUs;
+    if (coastUs > config.maxCoastUs && fitAccelMatches)
+    {
+        reference.x = fit.x;
+        reference.y = fit.y;
+        coastUs = 0;
+    }
+}
+}  // namespace control::chassis
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "chassis_kinematics.hpp"
+
+namespace control::chassis
+{
+/// Gains and constants, to be set by the user.
+struct TractionControlConfig
+{
+    /// Relative slip below which a wheel's torque is not cut.
+    const float slipThreshold{0.15f};
+    /// Torque cut per unit of relative slip above the threshold.
+    const float torqueCutGain{2.0f};
+    /// Smallest fraction of the commanded torque a slipping wheel is left with.
+    const float minTorqueScale{0.3f};
+    /// Implied wheel speeds below this, in rad/s, are treated as this when computing relative slip.
+    const float minReferenceSpeed{2.5f};
+    /// Weight of a new torque scale in the low pass filtered one, to avoid chatter.
+    const float torqueScaleAlpha{0.3f};
+    /// Largest relative residual of the all-wheel fit at which the wheels agree with each other
+    /// well enough to correct the reference velocity.
+    const float maxFitResidual{0.05f};
+    /// Largest difference, in m/s^2, between the acceleration of the all-wheel fit and the
+    /// accelerometer at which the wheels are trusted to correct the reference velocity. Above it
+    /// the wheels are spinning up or locking faster than the chassis moves.
+    const float maxAccelMismatch{2.0f};
+    /// Fraction of the gap between the reference velocity and the all-wheel fit closed per update
+    /// while the wheels are trusted.
+    const float wheelCorrectionGain{0.05f};
+    /// Longest the reference velocity may run on the accelerometer alone, in microseconds, before
+    /// it is reset to the all-wheel fit, unless the fit's acceleration disagrees with the
+    /// accelerometer.
+    const uint32_t maxCoastUs{300'000};
+};
+
+/// Chassis motion measured by the IMU, in the chassis frame.
+struct ImuMotion
+{
+    float accelX;   ///< Forward acceleration, in m/s^2.
+    float accelY;   ///< Leftward acceleration, in m/s^2.
+    float yawRate;  ///< Counter-clockwise yaw rate, in rad/s.
+};
+
+/**
+ * @brief Detects wheels that have lost traction and cuts their torque in proportion.
+ *
+ * Four mecanum wheels over-determine the body twist by one, so the wheels alone cannot tell which
+ * of them slips: any disagreement shows up equally on all four. The reference twist therefore
+ * comes from the IMU. Its rotation is the gyro yaw rate, and its velocity is integrated from the
+ * accelerometer.
+ *
+ * The wheels are trusted to pull the velocity slowly towards the least squares fit to all four of
+ * them, bounding the integration drift, only while the fit leaves a small residual and the fit
+ * accelerates as the accelerometer does. Four wheels spinning up together fit each other well, so
+ * the acceleration check is what keeps them from dragging the reference along. If the wheels are
+ * not trusted for longer than `maxCoastUs` the velocity is reset to the fit, again only while its
+ * acceleration agrees with the accelerometer.
+ *
+ * Each wheel's measured speed is compared on its own against the speed the reference implies for
+ * it, and every wheel over the threshold has its torque cut in proportion to how far its relative
+ * slip exceeds it.
+ */
+class TractionController
+{
+public:
+    using Kinematics = ChassisKinematics<4>;
+    static constexpr std::size_t NUM_WHEELS = Kinematics::NUM_WHEELS;
+
+    TractionController(const TractionControlConfig &config, const Kinematics &kinematics);
+
+    /**
+     * Re-estimates slip for every wheel. Call once per refresh.
+     *
+     * @param[in] wheelSpeeds measured angular velocity of every wheel, in rad/s.
+     * @param[in] imu chassis motion measured by the IMU.
+     * @param[in] dtUs time since the previous update, in microseconds.
+     * @param[in] enabled false to release every wheel, for example when a wheel is offline and the
+     * remaining ones cannot be cross checked.
+     */
+    void update(
+        const Kinematics::WheelSpeeds &wheelSpeeds,
+        const ImuMotion &imu,
+        uint32_t dtUs,
+        bool enabled);
+
+    /**
+     * @return the fraction of commanded torque `wheel` should receive, in [minTorqueScale, 1].
+     */
+    float getTorqueScale(uint8_t wheel) const { return torqueScale[wheel]; }
+
+    /**
+     * @return the last relative slip measured on `wheel`.
+     */
+    float getSlip(uint8_t wheel) const { return slip[wheel]; }
+
+    /**
+     * @return the reference twist the wheels were last compared against.
+     */
+    const Twist &getReference() const { return reference; }
+
+private:
+    const TractionControlConfig &config;
+    const Kinematics &kinematics;
+
+    /**
+     * Advances the reference twist by `dtUs` from the IMU and corrects its velocity towards `fit`
+     * when `fitResidual` and the fit's acceleration show the wheels can be trusted.
+     */
+    void updateReference(const Twist &fit, float fitResidual, const ImuMotion &imu, uint32_t dtUs);
+
+    Twist reference;
+    /// All-wheel fit of the previous update, to measure the wheels' acceleration.
+    Twist lastFit;
+    /// False until the reference has been seeded from the wheels, and again while disabled.
+    bool referenceValid;
+    /// Time the reference velocity has run on the accelerometer alone, in microseconds.
+    uint32_t coastUs;
+
+    std::array<float, NUM_WHEELS> slip;
+    std::array<float, NUM_WHEELS> torqueScale;
+};
+}  // namespace control::chassis
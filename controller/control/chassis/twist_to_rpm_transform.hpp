@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "chassis_kinematics.hpp"
+
+namespace control::chassis
+{
+/**
+ * @brief Maps a body twist straight to saturated motor shaft RPMs.
+ *
+ * The inverse kinematics and the wheel rad/s to shaft RPM conversion are folded into one 4x3
+ * matrix when the transform is constructed, which for a constexpr transform is at compile time.
+ * Applying it costs one matrix-vector multiply and one saturation step. Saturation scales all
+ * wheels down together, so a twist beyond the motors' envelope keeps its direction.
+ */
+class TwistToRpmTransform
+{
+public:
+    using Matrix = ChassisKinematics<4>::InverseMatrix;
+    using WheelRpm = ChassisKinematics<4>::WheelSpeeds;
+
+    /**
+     * @param[in] kinematics kinematics mapping a twist to wheel speeds.
+     * @param[in] rpmPerUnitWheelSpeed shaft RPM per unit of wheel speed output by `kinematics`.
+     * @param[in] maxRpm shaft RPM no wheel may exceed.
+     */
+    constexpr TwistToRpmTransform(
+        const ChassisKinematics<4> &kinematics,
+        float rpmPerUnitWheelSpeed,
+        float maxRpm)
+        : matrix(),
+          maxRpm(maxRpm)
+    {
+        for (std::size_t i = 0; i < matrix.size(); i++)
+        {
+            for (std::size_t j = 0; j < 3; j++)
+            {
+                matrix[i][j] = kinematics.getInverseMatrix()[i][j] * rpmPerUnitWheelSpeed;
+            }
+        }
+    }
+
+    /**
+     * @return shaft RPM of each wheel for `twist`, scaled down together so none exceeds maxRpm.
+     */
+    constexpr WheelRpm apply(const Twist &twist) const
+    {
+        WheelRpm rpm = applyUnsaturated(twist);
+
+        float peak = 0.0f;
+        for (float wheel : rpm)
+        {
+            float magnitude = wheel < 0 ? -wheel : wheel;
+            peak = magnitude > peak ? magnitude : peak;
+        }
+
+        if (peak > maxRpm)
+        {
+            for (float &wheel : rpm)
+            {
+                wheel *= maxRpm / peak;
+            }
+        }
+        return rpm;
+    }
+
+    /**
+     * @return shaft RPM of each wheel for `twist`, without saturation.
+     */
+    constexpr WheelRpm applyUnsaturated(const Twist &twist) const
+    {
+        WheelRpm rpm{};
+        for (std::size_t i = 0; i < rpm.size(); i++)
+        {
+            rpm[i] = matrix[i][0] * twist.x + matrix[i][1] * twist.y + matrix[i][2] * twist.z;
+        }
+        return rpm;
+    }
+
+    /**
+     * @return the largest multiple of `direction` that no wheel needs more than maxRpm for.
+     */
+    constexpr float getMaxScaleAlong(const Twist &direction) const
+    {
+        float peak = 0.0f;
+        for (float wheel : applyUnsaturated(direction))
+        {
+            float magnitude = wheel < 0 ? -wheel : wheel;
+            peak = magnitude > peak ? magnitude : peak;
+        }
+        return peak > 0.0f ? maxRpm / peak : 0.0f;
+    }
+
+    constexpr const Matrix &getMatrix() const { return matrix; }
+
+private:
+    Matrix matrix;
+    float maxRpm;
+};
+}  // namespace control::chassis
@@ -21,26 +21,36 @@
 
 #include "tap/algorithms/math_user_utils.hpp"
 #include "tap/communication/serial/remote.hpp"
-#include "tap/communication/sensors/imu/mpu6500/mpu6500.hpp"
-#include "tap/architecture/clock.hpp"
+
+#include "architecture/clock.hpp"
+#include "control/imu/imu_pipeline.hpp"
 
 using tap::algorithms::limitVal;
 using tap::communication::serial::Remote;
-using tap::communication::sensors::imu::mpu6500::Mpu6500;
 
 namespace control
 {
 
 #define PI 3.1415927f
 
-ControlOperatorInterface::ControlOperatorInterface(Remote &remote, Mpu6500& imu)
+ControlOperatorInterface::ControlOperatorInterface(RemoteInput &remote, imu::ImuPipeline& imu)
         : remote(remote), imu(imu) {}
 
+void ControlOperatorInterface::updateRemoteFrameTime() {
+    uint32_t updateCounter = remote.getUpdateCounter();
+    if (updateCounter != remoteUpdateCounter) {
+        remoteUpdateCounter = updateCounter;
+        remoteFrameTime = architecture::clock::getTimeMicroseconds();
+    }
+}
+
 std::tuple<double, double, double> ControlOperatorInterface::pollInput() {
+    imuSampleTime = imu.getLatestSample().timestampUs;
+
     /* use doubles for enhanced precision when processing return values */
     double x    = static_cast<double>(std::clamp(remote.getChannel(Remote::Channel::LEFT_HORIZONTAL),  -1.0f, 1.0f));
     double y    = static_cast<double>(std::clamp(remote.getChannel(Remote::Channel::LEFT_VERTICAL),    -1.0f, 1.0f));
-    double yaw  = static_cast<double>(modm::toRadian(imu.getYaw()));
+    double yaw  = static_cast<double>(modm::toRadian(imu.getYawAt(architecture::clock::getTimeMicroseconds())));
     double rotX = x * std::cos(-yaw) - y * std::sin(-yaw);
     double rotY = x * std::sin(-yaw) + y * std::cos(-yaw);
 
@@ -49,28 +59,14 @@ std::tuple<double, double, double> ControlOperatorInterface::pollInput() {
     return std::make_tuple(rotX, rotY, rx);
 }
 
-float ControlOperatorInterface::getChassisOmniLeftFrontInput() {
-    auto [vx, vy, w] = pollInput();
-    double denom = std::max(std::abs(vy) + std::abs(vx) + std::abs(w), static_cast<double>(1.0));
-    return (vy + vx + w) / denom;
-}
-
-float ControlOperatorInterface::getChassisOmniLeftBackInput() {
-    auto [vx, vy, w] = pollInput();
-    double denom = std::max(std::abs(vy) + std::abs(vx) + std::abs(w), static_cast<double>(1.0));
-    return (vy - vx + w) / denom;
-}
-
-float ControlOperatorInterface::getChassisOmniRightFrontInput() {
+chassis::Twist ControlOperatorInterface::getChassisStickInput() {
     auto [vx, vy, w] = pollInput();
-    double denom = std::max(std::abs(vy) + std::abs(vx) + std::abs(w), static_cast<double>(1.0));
-    return (vy - vx - w) / denom;
-}
 
-float ControlOperatorInterface::getChassisOmniRightBackInput() {
-    auto [vx, vy, w] = pollInput();
-    double denom = std::max(std::abs(vy) + std::abs(vx) + std::abs(w), static_cast<double>(1.0));
-    return (vy + vx - w) / denom;
+    /* sticks are right and clockwise positive, the chassis frame is left and counter-clockwise */
+    return chassis::Twist{
+        static_cast<float>(vy),
+        static_cast<float>(-vx),
+        static_cast<float>(-w)};
 }
 
 }  // namespace control
@@ -22,30 +22,69 @@
 // #include "tap/communication/serial/remote.hpp"
 // #include "tap/communication/sensors/imu/mpu6500/mpu6500.hpp"
 
+#include <cstdint>
 #include <tuple>
 
-namespace tap::communication
+#include "control/chassis/chassis_kinematics.hpp"
+
+#if defined(PLATFORM_HOSTED) && !defined(ENV_UNIT_TESTS)
+#include "communication/serial/virtual_remote.hpp"
+#endif
+
+namespace tap::communication::serial
 {
-namespace serial { class Remote; }
-namespace sensors::imu::mpu6500 { class Mpu6500; }
+class Remote;
 }
 
 namespace control
 {
+namespace imu
+{
+class ImuPipeline;
+}
+
 class ControlOperatorInterface
 {
 public:
-    ControlOperatorInterface(tap::communication::serial::Remote& remote,
-                             tap::communication::sensors::imu::mpu6500::Mpu6500& imu);
+#if defined(PLATFORM_HOSTED) && !defined(ENV_UNIT_TESTS)
+    /// Hosted runs have no receiver and read frames sent by testing/remote_bridge.py instead.
+    using RemoteInput = communication::serial::VirtualRemote;
+#else
+    using RemoteInput = tap::communication::serial::Remote;
+#endif
+
+    ControlOperatorInterface(RemoteInput& remote, imu::ImuPipeline& imu);
+
+    /**
+     * Records the arrival time of the latest remote frame. Call right after `Remote::read`.
+     */
+    void updateRemoteFrameTime();
 
     std::tuple<double, double, double> pollInput();
 
-    float getChassisOmniLeftFrontInput();
-    float getChassisOmniLeftBackInput();
-    float getChassisOmniRightFrontInput();
-    float getChassisOmniRightBackInput();
+    /**
+     * @return the field-rotated stick input as a chassis-frame twist (forward, left,
+     * counter-clockwise), in stick deflections. The chassis saturates whatever twist this scales
+     * to, keeping its direction, so the components are not normalized against each other here.
+     */
+    chassis::Twist getChassisStickInput();
+
+    /**
+     * @return the time the remote frame read by the last `pollInput` arrived, in microseconds.
+     */
+    uint32_t getRemoteFrameTime() const { return remoteFrameTime; }
+
+    /**
+     * @return the time the IMU sample used by the last `pollInput` was taken, in microseconds.
+     */
+    uint32_t getImuSampleTime() const { return imuSampleTime; }
+
 private:
-    tap::communication::serial::Remote& remote;
-    tap::communication::sensors::imu::mpu6500::Mpu6500& imu;
+    RemoteInput& remote;
+    imu::ImuPipeline& imu;
+
+    uint32_t remoteUpdateCounter{0};
+    uint32_t remoteFrameTime{0};
+    uint32_t imuSampleTime{0};
 };
 }  // namespace control
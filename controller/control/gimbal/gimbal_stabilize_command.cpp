@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "gimbal_stabilize_command.hpp"
+
+#include "control/imu/imu_pipeline.hpp"
+#include "diagnostics/scheduler_costs.hpp"
+
+#include "gimbal_subsystem.hpp"
+
+namespace control::gimbal
+{
+GimbalStabilizeCommand::GimbalStabilizeCommand(
+    GimbalSubsystem &gimbal,
+    imu::ImuPipeline &imu,
+    diagnostics::SchedulerCosts &schedulerCosts)
+    : gimbal(gimbal),
+      imu(imu),
+      schedulerCosts(schedulerCosts)
+{
+    addSubsystemRequirement(&gimbal);
+}
+
+void GimbalStabilizeCommand::execute()
+{
+    SCHEDULER_COST_SCOPE(schedulerCosts);
+
+    gimbal.setDesiredYawVelocity(-imu.getLatestSample().yawRate);
+}
+
+void GimbalStabilizeCommand::end(bool) { gimbal.setDesiredYawVelocity(0); }
+}  // namespace control::gimbal
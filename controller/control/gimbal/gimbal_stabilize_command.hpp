@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "tap/control/command.hpp"
+
+namespace control::imu
+{
+class ImuPipeline;
+}
+
+namespace diagnostics
+{
+class SchedulerCosts;
+}
+
+namespace control::gimbal
+{
+class GimbalSubsystem;
+
+/**
+ * @brief Holds the gimbal's heading steady while the chassis rotates underneath it. Each tick the
+ * chassis yaw rate measured by the IMU is fed back as an equal and opposite yaw velocity request.
+ */
+class GimbalStabilizeCommand : public tap::control::Command
+{
+public:
+    /**
+     * @brief Construct a new Gimbal Stabilize Command object
+     *
+     * @param gimbal Gimbal to control.
+     * @param imu IMU pipeline of the chassis mounted IMU, used to measure the chassis yaw rate.
+     * @param schedulerCosts Accounts and traces the cost of each execute.
+     */
+    GimbalStabilizeCommand(
+        GimbalSubsystem &gimbal,
+        imu::ImuPipeline &imu,
+        diagnostics::SchedulerCosts &schedulerCosts);
+
+    const char *getName() const override { return "Gimbal stabilize"; }
+
+    void initialize() override {}
+
+    void execute() override;
+
+    void end(bool interrupted) override;
+
+    bool isFinished() const { return false; }
+
+private:
+    GimbalSubsystem &gimbal;
+
+    imu::ImuPipeline &imu;
+
+    diagnostics::SchedulerCosts &schedulerCosts;
+};
+}  // namespace control::gimbal
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "gimbal_subsystem.hpp"
+
+#include "tap/algorithms/math_user_utils.hpp"
+
+#include "diagnostics/scheduler_costs.hpp"
+
+#include "drivers.hpp"
+
+using tap::algorithms::limitVal;
+
+namespace control::gimbal
+{
+GimbalSubsystem::GimbalSubsystem(Drivers &drivers, const GimbalConfig &config)
+    : tap::control::Subsystem(&drivers),
+      desiredYawRpm(0),
+      yawVelocityPid(),
+      tuningActive(false),
+      tuningOutput(0),
+      yawMotor(&drivers, config.yawId, config.canBus, false, "Yaw")
+{
+    setVelocityPidParameter(config.yawVelocityPidConfig);
+}
+
+void GimbalSubsystem::initialize()
+{
+    yawMotor.initialize();
+    getDrivers().canTxScheduler.addMotor(&yawMotor);
+}
+
+void GimbalSubsystem::setDesiredYawVelocity(float degPerSec)
+{
+    desiredYawRpm = limitVal(degPerSecToRpm(degPerSec), -MAX_YAW_SPEED_RPM, MAX_YAW_SPEED_RPM);
+}
+
+void GimbalSubsystem::refresh()
+{
+    SCHEDULER_COST_SCOPE(getDrivers().schedulerCosts);
+
+    if (tuningActive)
+    {
+        yawVelocityPid.reset();
+        yawMotor.setDesiredOutput(tuningOutput);
+        return;
+    }
+
+    yawVelocityPid.update(desiredYawRpm - yawMotor.getShaftRPM());
+    yawMotor.setDesiredOutput(yawVelocityPid.getValue());
+}
+
+Drivers &GimbalSubsystem::getDrivers() const
+{
+    return *static_cast<Drivers *>(drivers);
+}
+
+void GimbalSubsystem::setVelocityPidParameter(const Pid::Parameter &parameter)
+{
+    yawVelocityPid.setParameter(parameter);
+}
+}  // namespace control::gimbal
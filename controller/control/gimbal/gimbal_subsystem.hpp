@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "tap/control/subsystem.hpp"
+#include "tap/util_macros.hpp"
+
+#include "modm/math/filter/pid.hpp"
+
+#include "control/algorithms/relay_auto_tuner.hpp"
+#include "control/motor/timestamped_dji_motor.hpp"
+#include "control/tuning/tunable_velocity_loop.hpp"
+
+class Drivers;
+
+namespace control::gimbal
+{
+struct GimbalConfig
+{
+    tap::motor::MotorId yawId;
+    tap::can::CanBus canBus;
+    modm::Pid<float>::Parameter yawVelocityPidConfig;
+};
+
+///
+/// @brief This subsystem encapsulates the yaw motor of the gimbal. The yaw motor is velocity
+/// controlled, the desired velocity being set by whatever command owns the subsystem, or driven
+/// open loop by a tuning command.
+///
+class GimbalSubsystem : public tap::control::Subsystem, public tuning::TunableVelocityLoop
+{
+public:
+    using Pid = modm::Pid<float>;
+
+#if defined(PLATFORM_HOSTED) && defined(ENV_UNIT_TESTS)
+    using Motor = testing::NiceMock<motor::TimestampedDjiMotor>;
+#else
+    using Motor = motor::TimestampedDjiMotor;
+#endif
+
+    static constexpr float MAX_YAW_SPEED_RPM = 320;
+
+    /// Relay auto-tune of the yaw motor around rest.
+    static constexpr algorithms::RelayAutoTunerConfig YAW_AUTO_TUNE_CONFIG{
+        .setpointRpm = 0,
+        .relayOutput = 3'000,
+        .biasOutput = 0,
+        .hysteresisRpm = 5,
+        .settleCycles = 3,
+        .measureCycles = 5,
+        .timeoutUs = 20'000'000,
+        .maxDeviationRpm = MAX_YAW_SPEED_RPM,
+        .rule = algorithms::TuningRule::ZIEGLER_NICHOLS_PI,
+        .maxOutput = 8'000,
+    };
+
+    GimbalSubsystem(Drivers& drivers, const GimbalConfig& config);
+
+    ///
+    /// @brief Initializes the yaw motor.
+    ///
+    void initialize() override;
+
+    ///
+    /// @brief Sets the desired yaw velocity of the gimbal relative to the chassis.
+    ///
+    /// @param degPerSec Desired yaw velocity in degrees per second. Positive is counter-clockwise
+    /// when viewed from above.
+    ///
+    void setDesiredYawVelocity(float degPerSec);
+
+    ///
+    /// @brief Runs the velocity PID controller for the yaw motor.
+    ///
+    void refresh() override;
+
+    const char* getName() override { return "Gimbal"; }
+
+    tap::control::Subsystem& getTunedSubsystem() override { return *this; }
+
+    float getTunedVelocityRpm() const override { return yawMotor.getShaftRPM(); }
+
+    bool isTunedMotorOnline() const override { return yawMotor.isMotorOnline(); }
+
+    void setTuningOutput(float output) override
+    {
+        tuningActive = true;
+        tuningOutput = output;
+    }
+
+    void clearTuningOutput() override { tuningActive = false; }
+
+    void setVelocityPidParameter(const Pid::Parameter& parameter) override;
+
+private:
+    static inline float degPerSecToRpm(float degPerSec) { return degPerSec / 6.0f; }
+
+    ///
+    /// @return The drivers passed to the constructor, which `Subsystem` keeps as `tap::Drivers`.
+    ///
+    Drivers& getDrivers() const;
+
+    /// Desired yaw motor velocity, in RPM.
+    float desiredYawRpm;
+
+    /// PID controller. Input desired yaw velocity, output desired motor output.
+    Pid yawVelocityPid;
+
+    /// Whether the yaw motor is driven by `tuningOutput` instead of its PID.
+    bool tuningActive;
+    float tuningOutput;
+
+protected:
+    /// Yaw motor.
+    Motor yawMotor;
+};  // class GimbalSubsystem
+}  // namespace control::gimbal
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "gyro_bias_estimator.hpp"
+
+#include <cmath>
+
+namespace control::imu
+{
+void GyroBiasEstimator::update(float yawRate, bool wheelsStopped)
+{
+    float delta = yawRate - mean;
+    mean += STATISTICS_ALPHA * delta;
+    variance = (1.0f - STATISTICS_ALPHA) * (variance + STATISTICS_ALPHA * delta * delta);
+
+    if (!wheelsStopped || variance > STATIONARY_VARIANCE || std::fabs(mean) > MAX_BIAS)
+    {
+        stationarySamples = 0;
+        return;
+    }
+
+    if (stationarySamples < STATIONARY_SAMPLES)
+    {
+        stationarySamples++;
+        return;
+    }
+
+    bias += BIAS_ALPHA * (mean - bias);
+}
+}  // namespace control::imu
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace control::imu
+{
+/**
+ * @brief Continuously re-estimates the gyroscope z-axis bias while the robot is standing still.
+ *
+ * Keeps an exponentially weighted mean and variance of the raw yaw rate, so memory and per-sample
+ * cost are constant regardless of how long the robot has been running. The robot is considered
+ * stationary when the caller reports the wheels as stopped and the yaw rate variance has stayed
+ * below `STATIONARY_VARIANCE` for `STATIONARY_SAMPLES` samples in a row. While stationary, the bias
+ * estimate slowly tracks the mean yaw rate.
+ */
+class GyroBiasEstimator
+{
+public:
+    /// Weight of a new sample in the running mean and variance.
+    static constexpr float STATISTICS_ALPHA = 0.02f;
+    /// Weight of the running mean in the bias estimate while stationary.
+    static constexpr float BIAS_ALPHA = 0.002f;
+    /// Yaw rate variance, in (deg/s)^2, below which the gyro is considered at rest.
+    static constexpr float STATIONARY_VARIANCE = 0.05f;
+    /// Number of consecutive at-rest samples required before the bias is updated.
+    static constexpr uint32_t STATIONARY_SAMPLES = 200;
+    /// Largest bias, in deg/s, that will be accepted. Anything larger is real rotation.
+    static constexpr float MAX_BIAS = 2.0f;
+
+    /**
+     * Feeds one gyroscope sample into the estimator.
+     *
+     * @param[in] yawRate raw gyroscope z-axis reading, in deg/s.
+     * @param[in] wheelsStopped whether the drive wheels are currently stopped.
+     */
+    void update(float yawRate, bool wheelsStopped);
+
+    /**
+     * @return the current bias estimate, in deg/s.
+     */
+    float getBias() const { return bias; }
+
+    /**
+     * @return whether the last sample was taken while the robot was considered stationary.
+     */
+    bool isStationary() const { return stationarySamples >= STATIONARY_SAMPLES; }
+
+private:
+    float mean{0};
+    float variance{0};
+    float bias{0};
+    uint32_t stationarySamples{0};
+};
+}  // namespace control::imu
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "imu_pipeline.hpp"
+
+#include "tap/communication/sensors/imu/mpu6500/mpu6500.hpp"
+
+using tap::communication::sensors::imu::mpu6500::Mpu6500;
+
+namespace control::imu
+{
+/// @return `angle` wrapped into [-180, 180) degrees.
+static inline float wrapDegrees(float angle)
+{
+    while (angle >= 180.0f) angle -= 360.0f;
+    while (angle < -180.0f) angle += 360.0f;
+    return angle;
+}
+
+ImuPipeline::ImuPipeline(Mpu6500 &imu) : imu(imu) {}
+
+void ImuPipeline::initialize()
+{
+    imu.init(SAMPLE_FREQUENCY, MAHONY_KP, MAHONY_KI);
+    mahony.begin(SAMPLE_FREQUENCY, MAHONY_KP, MAHONY_KI);
+    initialized = true;
+}
+
+void ImuPipeline::update()
+{
+    if (!initialized)
+    {
+        return;
+    }
+
+    imu.read();
+
+    // Without a new sample there is nothing to fuse; getYawAt extrapolates from the history
+    uint32_t dataReceivedTime = imu.getPrevIMUDataReceivedTime();
+    if (dataReceivedTime != lastDataReceivedTime)
+    {
+        lastDataReceivedTime = dataReceivedTime;
+        fuse(dataReceivedTime);
+    }
+}
+
+void ImuPipeline::fuse(uint32_t sampleTimeUs)
+{
+    // Still stepped for the driver's calibration and heater control, which only run from it. Its
+    // own orientation integrates the uncorrected gyro and is not used.
+    imu.periodicIMUUpdate();
+
+    float rawYawRate = imu.getGz();
+    biasEstimator.update(rawYawRate, maxAbsWheelRpm <= STATIONARY_WHEEL_RPM);
+
+    float yawRate = rawYawRate - biasEstimator.getBias();
+    mahony.updateIMU(imu.getGx(), imu.getGy(), yawRate, imu.getAx(), imu.getAy(), imu.getAz());
+
+    newest ^= 1;
+    history[newest] = OrientationSample{
+        .timestampUs = sampleTimeUs,
+        .yaw = wrapDegrees(mahony.getYaw()),
+        .yawRate = yawRate,
+        .accelX = imu.getAx(),
+        .accelY = imu.getAy(),
+    };
+}
+
+float ImuPipeline::getYawAt(uint32_t timeUs) const
+{
+    const OrientationSample &latest = history[newest];
+    const OrientationSample &previous = history[newest ^ 1];
+
+    int32_t sinceLatest = static_cast<int32_t>(timeUs - latest.timestampUs);
+    if (sinceLatest >= 0)
+    {
+        uint32_t dt = sinceLatest > static_cast<int32_t>(MAX_EXTRAPOLATION_US)
+                          ? MAX_EXTRAPOLATION_US
+                          : static_cast<uint32_t>(sinceLatest);
+        return wrapDegrees(latest.yaw + latest.yawRate * dt * 1e-6f);
+    }
+
+    uint32_t span = latest.timestampUs - previous.timestampUs;
+    int32_t sincePrevious = static_cast<int32_t>(timeUs - previous.timestampUs);
+    if (span == 0 || sincePrevious <= 0)
+    {
+        return previous.yaw;
+    }
+
+    float t = static_cast<float>(sincePrevious) / span;
+    return wrapDegrees(previous.yaw + wrapDegrees(latest.yaw - previous.yaw) * t);
+}
+}  // namespace control::imu
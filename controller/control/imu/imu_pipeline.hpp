@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "tap/algorithms/MahonyAHRS.h"
+
+#include "gyro_bias_estimator.hpp"
+
+namespace tap::communication::sensors::imu::mpu6500
+{
+class Mpu6500;
+}
+
+namespace control::imu
+{
+/// Orientation of the chassis at the instant the IMU sample was taken.
+struct OrientationSample
+{
+    uint32_t timestampUs;  ///< Time the raw IMU data was received, in microseconds.
+    float yaw;             ///< Fused, bias corrected yaw, in degrees.
+    float yawRate;         ///< Bias corrected gyroscope z-axis reading, in degrees per second.
+    float accelX;          ///< Accelerometer x-axis (chassis forward) reading, in m/s^2.
+    float accelY;          ///< Accelerometer y-axis (chassis left) reading, in m/s^2.
+};
+
+/**
+ * @brief Runs the IMU fusion once per new sample instead of once per control tick.
+ *
+ * The Mpu6500 is read as often as possible from the main loop and the Mahony filter is stepped
+ * each time a fresh sample lands, so the fused orientation is never older than one IMU sample
+ * period. Each fused result is kept with the time its raw data was received, letting consumers ask
+ * for the yaw at an arbitrary timestamp: between the last two samples it is interpolated, past the
+ * newest sample it is extrapolated by integrating the latest gyro reading.
+ *
+ * Taproot does not expose the MPU6500's data-ready interrupt, so new samples are found by polling:
+ * `update` compares the driver's received-data timestamp with the last one fused. A sample is
+ * therefore fused up to one main loop iteration after it arrives, and a missed or late sample is
+ * never fused twice; consumers keep extrapolating from the newest sample until the next one lands.
+ *
+ * Yaw is not observable by the accelerometer, so the Mahony yaw is a pure integral of the gyro and
+ * any gyro bias turns into heading drift. The pipeline therefore runs its own Mahony filter, fed
+ * with the yaw rate after the bias estimated by a GyroBiasEstimator has been subtracted.
+ */
+class ImuPipeline
+{
+public:
+    static constexpr float SAMPLE_FREQUENCY = 1000;
+    static constexpr float MAHONY_KP = 0.5f;
+    static constexpr float MAHONY_KI = 0;
+
+    /// Gyro integration past the newest sample is capped at this many microseconds.
+    static constexpr uint32_t MAX_EXTRAPOLATION_US = 5'000;
+
+    /// Shaft RPM below which a drive wheel is considered stopped.
+    static constexpr float STATIONARY_WHEEL_RPM = 20;
+
+    ImuPipeline(tap::communication::sensors::imu::mpu6500::Mpu6500 &imu);
+
+    /**
+     * Initializes the IMU at `SAMPLE_FREQUENCY`.
+     */
+    void initialize();
+
+    /**
+     * Reads the IMU and, if a new sample arrived, steps the fusion and records the result. Call
+     * this as often as possible. Does nothing until `initialize` has been called; until then the
+     * orientation reads as zero.
+     */
+    void update();
+
+    /**
+     * @return the most recently fused orientation sample.
+     */
+    const OrientationSample &getLatestSample() const { return history[newest]; }
+
+    /**
+     * @param[in] timeUs the time of interest, as returned by
+     * `architecture::clock::getTimeMicroseconds`.
+     * @return the fused yaw in degrees at `timeUs`.
+     */
+    float getYawAt(uint32_t timeUs) const;
+
+    /**
+     * Reports the speed of the fastest drive wheel, used to detect when the robot is stationary.
+     * Call this once per control tick.
+     *
+     * @param[in] maxAbsWheelRpm largest absolute shaft RPM across the drive wheels.
+     */
+    void setMaxWheelSpeed(float maxAbsWheelRpm) { this->maxAbsWheelRpm = maxAbsWheelRpm; }
+
+    /**
+     * @return the current gyroscope z-axis bias estimate, in deg/s.
+     */
+    float getYawRateBias() const { return biasEstimator.getBias(); }
+
+private:
+    tap::communication::sensors::imu::mpu6500::Mpu6500 &imu;
+
+    /// The two most recent samples, `newest` indexing the latest.
+    std::array<OrientationSample, 2> history{};
+    uint8_t newest{0};
+
+    bool initialized{false};
+
+    uint32_t lastDataReceivedTime{0};
+
+    GyroBiasEstimator biasEstimator;
+    /// Fuses the bias corrected gyro with the accelerometer.
+    Mahony mahony;
+    /// Wheels are assumed to be moving until the chassis reports otherwise.
+    float maxAbsWheelRpm{STATIONARY_WHEEL_RPM + 1};
+
+    void fuse(uint32_t sampleTimeUs);
+};
+}  // namespace control::imu
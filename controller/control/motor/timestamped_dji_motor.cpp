@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !(defined(PLATFORM_HOSTED) && defined(ENV_UNIT_TESTS))
+
+#include "timestamped_dji_motor.hpp"
+
+#include "architecture/clock.hpp"
+
+namespace control::motor
+{
+void TimestampedDjiMotor::processMessage(const modm::can::Message &message)
+{
+    if (message.getIdentifier() != getMotorIdentifier())
+    {
+        return;
+    }
+
+    lastFeedbackTime = architecture::clock::getTimeMicroseconds();
+    feedbackCount++;
+    tap::motor::DjiMotor::processMessage(message);
+}
+}  // namespace control::motor
+
+#endif
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#if defined(PLATFORM_HOSTED) && defined(ENV_UNIT_TESTS)
+#include <gmock/gmock.h>
+
+#include "tap/mock/dji_motor_mock.hpp"
+#else
+#include "tap/motor/dji_motor.hpp"
+#endif
+
+namespace control::motor
+{
+#if defined(PLATFORM_HOSTED) && defined(ENV_UNIT_TESTS)
+class TimestampedDjiMotor : public tap::mock::DjiMotorMock
+{
+public:
+    using tap::mock::DjiMotorMock::DjiMotorMock;
+
+    MOCK_METHOD(uint32_t, getLastFeedbackTime, (), (const));
+    MOCK_METHOD(uint32_t, getFeedbackAge, (uint32_t now), (const));
+    MOCK_METHOD(uint32_t, getFeedbackCount, (), (const));
+};
+#else
+/**
+ * @brief A DjiMotor that records when each of its feedback frames was dispatched.
+ *
+ * Frames are received into the CAN driver's interrupt fed queue and dispatched to the motor when
+ * the queue is drained (see `communication::can::drainReceiveQueue`). The recorded time is the
+ * dispatch time, so the queue should be drained right before the feedback is used.
+ */
+class TimestampedDjiMotor : public tap::motor::DjiMotor
+{
+public:
+    using tap::motor::DjiMotor::DjiMotor;
+
+    void processMessage(const modm::can::Message &message) override;
+
+    /**
+     * @return the time the last feedback frame was dispatched, in microseconds.
+     */
+    uint32_t getLastFeedbackTime() const { return lastFeedbackTime; }
+
+    /**
+     * @param[in] now the current time, in microseconds.
+     * @return microseconds since the last feedback frame was dispatched.
+     */
+    uint32_t getFeedbackAge(uint32_t now) const { return now - lastFeedbackTime; }
+
+    /**
+     * @return the number of feedback frames dispatched since reset.
+     */
+    uint32_t getFeedbackCount() const { return feedbackCount; }
+
+private:
+    uint32_t lastFeedbackTime{0};
+    uint32_t feedbackCount{0};
+};
+#endif
+}  // namespace control::motor
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "remote_failsafe.hpp"
+
+#include <algorithm>
+
+#include "control_operator_interface.hpp"
+#include "drivers.hpp"
+
+namespace control
+{
+RemoteFailsafe::RemoteFailsafe(
+    Drivers &drivers,
+    const ControlOperatorInterface &operatorInterface,
+    const RemoteFailsafeConfig &config)
+    : drivers(drivers),
+      operatorInterface(operatorInterface),
+      config(config)
+{
+}
+
+void RemoteFailsafe::init() { drivers.terminalSerial.addHeader("failsafe", this); }
+
+float RemoteFailsafe::update(uint32_t now)
+{
+    uint32_t frameAge = now - operatorInterface.getRemoteFrameTime();
+
+    if (frameAge <= config.frameTimeoutUs)
+    {
+        tripped = false;
+        outputScale = 1.0f;
+        return outputScale;
+    }
+
+    if (!tripped)
+    {
+        tripped = true;
+        trippedAtUs = now;
+        rampStartScale = outputScale;
+
+        tripCount++;
+        lastDetectionLatencyUs = frameAge;
+        maxDetectionLatencyUs = std::max(maxDetectionLatencyUs, frameAge);
+    }
+
+    uint32_t rampDurationUs = config.stopBoundUs - config.frameTimeoutUs - config.detectionSlackUs;
+    uint32_t sinceTrip = now - trippedAtUs;
+
+    outputScale = sinceTrip >= rampDurationUs
+                      ? 0.0f
+                      : rampStartScale * (1.0f - static_cast<float>(sinceTrip) / rampDurationUs);
+    return outputScale;
+}
+
+bool RemoteFailsafe::terminalSerialCallback(char *, modm::IOStream &outputStream, bool)
+{
+    outputStream << (tripped ? "tripped" : "ok") << ", tripped " << tripCount << " times"
+                 << modm::endl;
+    outputStream << "detection latency (us): last " << lastDetectionLatencyUs << ", max "
+                 << maxDetectionLatencyUs << modm::endl;
+    outputStream << "frame timeout " << config.frameTimeoutUs << " us, stop bound "
+                 << config.stopBoundUs << " us" << modm::endl;
+    return true;
+}
+}  // namespace control
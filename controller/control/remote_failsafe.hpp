@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "tap/communication/serial/terminal_serial.hpp"
+
+class Drivers;
+
+namespace control
+{
+class ControlOperatorInterface;
+
+/// Timing bounds, to be set by the user.
+struct RemoteFailsafeConfig
+{
+    /// Time without a remote frame after which the link is considered lost. The DR16 sends a frame
+    /// every 14 ms, so this must be comfortably above that.
+    const uint32_t frameTimeoutUs{30'000};
+    /// Time from the last remote frame by which the chassis must be commanded to a stop.
+    const uint32_t stopBoundUs{50'000};
+    /// Worst case delay between the timeout passing and it being noticed, one control tick.
+    const uint32_t detectionSlackUs{2'000};
+};
+
+/**
+ * @brief Stops the chassis within a guaranteed time of the remote link dropping.
+ *
+ * Tracks the arrival time of remote frames through the ControlOperatorInterface. Once no frame has
+ * arrived for `frameTimeoutUs`, the output scale ramps linearly from its current value to zero so
+ * that the chassis is fully stopped `stopBoundUs` after the last frame. When frames resume, output
+ * is restored immediately. The latency between the last frame and the failsafe tripping is printed
+ * under the "failsafe" terminal header.
+ */
+class RemoteFailsafe : public tap::communication::serial::TerminalSerialCallbackInterface
+{
+public:
+    RemoteFailsafe(
+        Drivers &drivers,
+        const ControlOperatorInterface &operatorInterface,
+        const RemoteFailsafeConfig &config);
+
+    /**
+     * Registers the "failsafe" terminal header.
+     */
+    void init();
+
+    /**
+     * Checks the remote link. Call once per control tick, before using the output scale.
+     *
+     * @param[in] now the current time, in microseconds.
+     * @return the fraction, in [0, 1], of the operator's command that should be applied.
+     */
+    float update(uint32_t now);
+
+    /**
+     * @return whether the remote link is currently considered lost.
+     */
+    bool isTripped() const { return tripped; }
+
+    bool terminalSerialCallback(
+        char *inputLine,
+        modm::IOStream &outputStream,
+        bool streamingEnabled) override;
+
+    void terminalSerialStreamCallback(modm::IOStream &) override {}
+
+private:
+    Drivers &drivers;
+    const ControlOperatorInterface &operatorInterface;
+    const RemoteFailsafeConfig &config;
+
+    bool tripped{true};
+    uint32_t trippedAtUs{0};
+    float outputScale{0};
+    float rampStartScale{0};
+
+    uint32_t tripCount{0};
+    uint32_t lastDetectionLatencyUs{0};
+    uint32_t maxDetectionLatencyUs{0};
+};
+}  // namespace control
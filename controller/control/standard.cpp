@@ -23,6 +23,9 @@
 
 #include "control/chassis/chassis_subsystem.hpp"
 #include "control/chassis/chassis_omni_drive_command.hpp"
+#include "control/gimbal/gimbal_subsystem.hpp"
+#include "control/gimbal/gimbal_stabilize_command.hpp"
+#include "control/tuning/relay_auto_tune_command.hpp"
 
 #include "drivers.hpp"
 
@@ -45,8 +48,48 @@ Robot::Robot(Drivers &drivers)
                 .rightFrontId = MotorId::MOTOR1,
                 .canBus = CanBus::CAN_BUS1,
                 .wheelVelocityPidConfig = modm::Pid<float>::Parameter(10, 0, 0, 0, 16'000),
+                .motorTimeoutUs = 10'000,
+                .wheelBaseM = 0.4f,
+                .trackWidthM = 0.4f,
+                .wheelVelocityFeedforward = 0,
+                .setpointSlewRpmPerSec = 0,
         }),
-        chassisOmniDrive(chassis, drivers.controlOperatorInterface)        
+        chassisOmniDrive(
+            chassis,
+            drivers.controlOperatorInterface,
+            drivers.latencyTracer,
+            drivers.remoteFailsafe,
+            drivers.schedulerCosts),
+        gimbal(
+            drivers,
+            gimbal::GimbalConfig{
+                .yawId = MotorId::MOTOR6,
+                .canBus = CanBus::CAN_BUS1,
+                .yawVelocityPidConfig = modm::Pid<float>::Parameter(20, 0, 0, 0, 8'000),
+        }),
+        gimbalStabilize(gimbal, drivers.imuPipeline, drivers.schedulerCosts),
+        chassisWheelAutoTune(
+            drivers,
+            "Chassis wheel auto-tune",
+            chassis,
+            chassis::ChassisSubsystem::WHEEL_AUTO_TUNE_CONFIG),
+        gimbalYawAutoTune(
+            drivers,
+            "Gimbal yaw auto-tune",
+            gimbal,
+            gimbal::GimbalSubsystem::YAW_AUTO_TUNE_CONFIG),
+        ctrlShiftZ(
+            &drivers,
+            {&chassisWheelAutoTune},
+            RemoteMapState(
+                {Remote::Key::CTRL, Remote::Key::SHIFT, Remote::Key::Z},
+                {Remote::Key::X})),
+        ctrlShiftX(
+            &drivers,
+            {&gimbalYawAutoTune},
+            RemoteMapState(
+                {Remote::Key::CTRL, Remote::Key::SHIFT, Remote::Key::X},
+                {Remote::Key::Z}))
 {
 }
 
@@ -63,21 +106,28 @@ void Robot::initializeSubsystems()
 {
     // STEP 4 (Tank Drive): initialize declared ChassisSubsystem
     chassis.initialize();
+    gimbal.initialize();
 }
 
 void Robot::registerSoldierSubsystems()
 {
     // STEP 5 (Tank Drive): register declared ChassisSubsystem
     drivers.commandScheduler.registerSubsystem(&chassis);
+    drivers.commandScheduler.registerSubsystem(&gimbal);
 }
 
 void Robot::setDefaultSoldierCommands()
 {
     // STEP 6 (Tank Drive): set ChassisTanKDriveCommand as default command for ChassisSubsystem
     chassis.setDefaultCommand(&chassisOmniDrive);
+    gimbal.setDefaultCommand(&gimbalStabilize);
 }
 
 void Robot::startSoldierCommands() {}
 
-void Robot::registerSoldierIoMappings() {}
+void Robot::registerSoldierIoMappings()
+{
+    drivers.commandMapper.addMap(&ctrlShiftZ);
+    drivers.commandMapper.addMap(&ctrlShiftX);
+}
 }  // namespace control
@@ -25,6 +25,10 @@
 
 #include "control/chassis/chassis_subsystem.hpp"
 #include "control/chassis/chassis_omni_drive_command.hpp"
+#include "control/gimbal/gimbal_subsystem.hpp"
+#include "control/gimbal/gimbal_stabilize_command.hpp"
+#include "control/tuning/armed_hold_command_mapping.hpp"
+#include "control/tuning/relay_auto_tune_command.hpp"
 
 class Drivers;
 
@@ -37,6 +41,16 @@ public:
 
     void initSubsystemCommands();
 
+    /**
+     * @return the motor whose feedback the control tick phase locks to. Every DJI motor sends
+     * feedback at the same rate but with its own phase, so the tick follows a single one: the
+     * chassis left front wheel, whose feedback the chassis PIDs consume.
+     */
+    const motor::TimestampedDjiMotor &getPhaseReferenceMotor() const
+    {
+        return chassis.getMotor(chassis::ChassisSubsystem::MotorId::LF);
+    }
+
 private:
     void initializeSubsystems();
     void registerSoldierSubsystems();
@@ -51,5 +65,20 @@ private:
 
     // STEP 2 (Tank Drive): declare ChassisTankDriveCommand
     chassis::ChassisOmniDriveCommand chassisOmniDrive;
+
+    gimbal::GimbalSubsystem gimbal;
+
+    gimbal::GimbalStabilizeCommand gimbalStabilize;
+
+    /// Relay auto-tune of the chassis wheel PIDs, run on the left front wheel.
+    tuning::RelayAutoTuneCommand chassisWheelAutoTune;
+
+    tuning::RelayAutoTuneCommand gimbalYawAutoTune;
+
+    /// Ctrl+Shift+Z runs the wheel auto-tune while held. Releasing any key aborts it.
+    tuning::ArmedHoldCommandMapping ctrlShiftZ;
+
+    /// Ctrl+Shift+X runs the yaw auto-tune while held. Releasing any key aborts it.
+    tuning::ArmedHoldCommandMapping ctrlShiftX;
 };
 }  // namespace control
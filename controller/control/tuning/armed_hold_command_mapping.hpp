@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "tap/control/hold_command_mapping.hpp"
+
+namespace control::tuning
+{
+/**
+ * @brief A HoldCommandMapping that only arms once the remote has been seen outside its state.
+ *
+ * A hold mapping schedules its commands on whatever state the remote reports, including the very
+ * first frame after boot or after the remote is powered on. For commands that must only start by
+ * deliberate operator action, such as an auto-tune that drives a motor into oscillation, this
+ * mapping ignores its state until a frame has arrived that does not match it. The operator then
+ * has to enter the state, and holding it keeps the commands scheduled as usual.
+ */
+class ArmedHoldCommandMapping : public tap::control::HoldCommandMapping
+{
+public:
+    using tap::control::HoldCommandMapping::HoldCommandMapping;
+
+    void executeCommandMapping(const tap::control::RemoteMapState &currState) override;
+
+private:
+    bool armed{false};
+};
+}  // namespace control::tuning
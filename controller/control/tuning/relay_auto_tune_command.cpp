@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "relay_auto_tune_command.hpp"
+
+#include "tap/errors/create_errors.hpp"
+
+#include "architecture/clock.hpp"
+#include "diagnostics/scheduler_costs.hpp"
+
+#include "drivers.hpp"
+#include "tunable_velocity_loop.hpp"
+
+using control::algorithms::RelayAutoTuner;
+
+namespace control::tuning
+{
+RelayAutoTuneCommand::RelayAutoTuneCommand(
+    Drivers &drivers,
+    const char *name,
+    TunableVelocityLoop &loop,
+    const algorithms::RelayAutoTunerConfig &config)
+    : drivers(drivers),
+      name(name),
+      loop(loop),
+      tuner(config),
+      motorLost(false),
+      lastExecuteUs(0),
+      executePeriodSumUs(0),
+      executeCount(0)
+{
+    addSubsystemRequirement(&loop.getTunedSubsystem());
+}
+
+void RelayAutoTuneCommand::initialize()
+{
+    uint32_t now = architecture::clock::getTimeMicroseconds();
+
+    tuner.start(now);
+    motorLost = false;
+    lastExecuteUs = 0;
+    executePeriodSumUs = 0;
+    executeCount = 0;
+}
+
+void RelayAutoTuneCommand::execute()
+{
+    SCHEDULER_COST_SCOPE(drivers.schedulerCosts);
+
+    uint32_t now = architecture::clock::getTimeMicroseconds();
+    if (executeCount > 0)
+    {
+        executePeriodSumUs += now - lastExecuteUs;
+    }
+    executeCount++;
+    lastExecuteUs = now;
+
+    if (!loop.isTunedMotorOnline())
+    {
+        motorLost = true;
+        loop.setTuningOutput(0);
+        return;
+    }
+
+    loop.setTuningOutput(tuner.update(loop.getTunedVelocityRpm(), now));
+}
+
+void RelayAutoTuneCommand::end(bool interrupted)
+{
+    loop.clearTuningOutput();
+
+    if (interrupted)
+    {
+        return;
+    }
+
+    if (motorLost)
+    {
+        RAISE_ERROR((&drivers), "auto-tune stopped, motor went offline");
+        return;
+    }
+
+    switch (tuner.getState())
+    {
+        case RelayAutoTuner::State::SUCCEEDED:
+        {
+            float controlPeriodS = executePeriodSumUs / ((executeCount - 1) * 1e6f);
+            loop.setVelocityPidParameter(algorithms::toPidParameter(
+                tuner.getGains(),
+                controlPeriodS,
+                tuner.getConfig().maxOutput));
+            break;
+        }
+        case RelayAutoTuner::State::TIMED_OUT:
+            RAISE_ERROR((&drivers), "auto-tune timed out");
+            break;
+        case RelayAutoTuner::State::DIVERGED:
+            RAISE_ERROR((&drivers), "auto-tune stopped, velocity out of range");
+            break;
+        case RelayAutoTuner::State::NO_OSCILLATION:
+            RAISE_ERROR((&drivers), "auto-tune found no oscillation");
+            break;
+        default:
+            break;
+    }
+}
+
+bool RelayAutoTuneCommand::isFinished() const { return motorLost || !tuner.isRunning(); }
+}  // namespace control::tuning
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "tap/control/command.hpp"
+
+#include "modm/math/filter/pid.hpp"
+
+#include "control/algorithms/relay_auto_tuner.hpp"
+
+class Drivers;
+
+namespace control::tuning
+{
+class TunableVelocityLoop;
+
+/**
+ * @brief Tunes a velocity loop's PID in place by relay feedback.
+ *
+ * While scheduled, the command drives the loop's tuned motor with a RelayAutoTuner's output. Once
+ * the tuner has measured the loop's ultimate gain and period, the resulting gains are discretized
+ * at the measured control period and applied to the loop with the configured output limit, and
+ * the command finishes.
+ *
+ * If the tuner fails, times out or the motor drops offline, the loop keeps its old gains and an
+ * error is raised. Descheduling the command early, e.g. by releasing its mapping, hands the motor
+ * back to the unchanged PID.
+ */
+class RelayAutoTuneCommand : public tap::control::Command
+{
+public:
+    /**
+     * @param name Name of this tuning, distinct from the robot's other auto-tune commands so their
+     * scheduler costs and traces can be told apart.
+     * @param loop Loop to tune. Its subsystem becomes this command's requirement.
+     * @param config Relay and safety limits for this loop.
+     */
+    RelayAutoTuneCommand(
+        Drivers &drivers,
+        const char *name,
+        TunableVelocityLoop &loop,
+        const algorithms::RelayAutoTunerConfig &config);
+
+    const char *getName() const override { return name; }
+
+    void initialize() override;
+
+    void execute() override;
+
+    void end(bool interrupted) override;
+
+    bool isFinished() const override;
+
+    /// @return the tuner, to inspect the last run's ultimate gain and period.
+    const algorithms::RelayAutoTuner &getTuner() const { return tuner; }
+
+private:
+    Drivers &drivers;
+
+    const char *const name;
+
+    TunableVelocityLoop &loop;
+
+    algorithms::RelayAutoTuner tuner;
+
+    bool motorLost;
+
+    uint32_t lastExecuteUs;
+    /// Time between consecutive executes, summed over the run, to discretize the gains with.
+    uint32_t executePeriodSumUs;
+    uint32_t executeCount;
+};
+}  // namespace control::tuning
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "tap/control/subsystem.hpp"
+
+#include "modm/math/filter/pid.hpp"
+
+namespace control::tuning
+{
+/**
+ * A subsystem velocity loop that a tuning command can take over: drive one motor open loop,
+ * read its velocity, and swap the loop's PID parameters while it runs.
+ */
+class TunableVelocityLoop
+{
+public:
+    virtual ~TunableVelocityLoop() = default;
+
+    /// @return the subsystem running the loop, for a tuning command to require.
+    virtual tap::control::Subsystem &getTunedSubsystem() = 0;
+
+    /// @return the tuned motor's measured velocity, in shaft RPM.
+    virtual float getTunedVelocityRpm() const = 0;
+
+    /// @return whether the tuned motor's feedback is fresh.
+    virtual bool isTunedMotorOnline() const = 0;
+
+    /**
+     * Drives the tuned motor with `output` from the next refresh on, bypassing its PID. The
+     * subsystem's other motors are held at rest.
+     */
+    virtual void setTuningOutput(float output) = 0;
+
+    /// Hands the tuned motor back to its PID.
+    virtual void clearTuningOutput() = 0;
+
+    /// Replaces the loop's PID parameters, taking effect on the next refresh.
+    virtual void setVelocityPidParameter(const modm::Pid<float>::Parameter &parameter) = 0;
+};
+}  // namespace control::tuning
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "cycle_profiler.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "drivers.hpp"
+
+namespace diagnostics
+{
+CycleProfiler::CycleProfiler(Drivers &drivers) : drivers(drivers) {}
+
+void CycleProfiler::init() { drivers.terminalSerial.addHeader("cycles", this); }
+
+uint8_t CycleProfiler::push(const char *name)
+{
+    uint8_t scope = UNCOUNTED;
+
+    if (depth < MAX_DEPTH)
+    {
+        uint8_t parent = depth == 0 ? NO_PARENT : openScopes[depth - 1].scope;
+        if (parent != UNCOUNTED)
+        {
+            scope = findOrAddScope(name, parent);
+        }
+        openScopes[depth].scope = scope;
+    }
+    depth++;
+
+    // Read last, so the profiler's own bookkeeping is not counted
+    if (depth <= MAX_DEPTH)
+    {
+        openScopes[depth - 1].startCycles = architecture::cycle_counter::read();
+    }
+    return scope;
+}
+
+void CycleProfiler::pop(uint8_t scope)
+{
+    uint32_t endCycles = architecture::cycle_counter::read();
+
+    if (depth == 0)
+    {
+        return;
+    }
+    depth--;
+
+    if (scope == UNCOUNTED || depth >= MAX_DEPTH)
+    {
+        return;
+    }
+
+    uint32_t cycles = endCycles - openScopes[depth].startCycles;
+    Scope &stats = scopes[scope];
+    stats.min = std::min(stats.min, cycles);
+    stats.max = std::max(stats.max, cycles);
+    stats.sum += cycles;
+    stats.count++;
+}
+
+void CycleProfiler::reset()
+{
+    for (uint8_t ii = 0; ii < numScopes; ii++)
+    {
+        scopes[ii] = Scope{scopes[ii].name, scopes[ii].parent, UINT32_MAX, 0, 0, 0};
+    }
+}
+
+uint8_t CycleProfiler::findOrAddScope(const char *name, uint8_t parent)
+{
+    for (uint8_t ii = 0; ii < numScopes; ii++)
+    {
+        if (scopes[ii].name == name && scopes[ii].parent == parent)
+        {
+            return ii;
+        }
+    }
+
+    if (numScopes == MAX_SCOPES)
+    {
+        return UNCOUNTED;
+    }
+
+    scopes[numScopes] = Scope{name, parent, UINT32_MAX, 0, 0, 0};
+    return numScopes++;
+}
+
+bool CycleProfiler::terminalSerialCallback(char *inputLine, modm::IOStream &outputStream, bool)
+{
+    if (inputLine != nullptr && std::strstr(inputLine, "reset") != nullptr)
+    {
+        reset();
+        outputStream << "cycle counts reset" << modm::endl;
+        return true;
+    }
+
+    outputStream << "cycles per call since reset, at "
+                 << static_cast<uint32_t>(architecture::cycle_counter::getFrequencyHz() / 1'000)
+                 << " kHz (min / mean / max, mean ns):" << modm::endl;
+    printChildren(outputStream, NO_PARENT, 0);
+    return true;
+}
+
+void CycleProfiler::printChildren(modm::IOStream &outputStream, uint8_t parent, uint8_t depth)
+    const
+{
+    for (uint8_t ii = 0; ii < numScopes; ii++)
+    {
+        const Scope &stats = scopes[ii];
+        if (stats.parent != parent)
+        {
+            continue;
+        }
+
+        for (uint8_t indent = 0; indent < depth; indent++)
+        {
+            outputStream << "  ";
+        }
+        outputStream << stats.name << ": ";
+
+        if (stats.count == 0)
+        {
+            outputStream << "no calls" << modm::endl;
+        }
+        else
+        {
+            uint32_t mean = static_cast<uint32_t>(stats.sum / stats.count);
+            outputStream << stats.min << " / " << mean << " / " << stats.max << ", "
+                         << architecture::cycle_counter::toNanoseconds(mean) << " ns ("
+                         << stats.count << " calls)" << modm::endl;
+        }
+
+        printChildren(outputStream, ii, depth + 1);
+    }
+}
+}  // namespace diagnostics
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "tap/communication/serial/terminal_serial.hpp"
+
+#include "architecture/cycle_counter.hpp"
+
+class Drivers;
+
+namespace diagnostics
+{
+/**
+ * @brief Counts the cycles spent in named, nestable scopes of the main loop.
+ *
+ * A scope is identified by the address of its name, a string literal, and the scope it is nested
+ * in, so the same name under two parents is counted twice. Each scope keeps the min, max and mean
+ * of its inclusive cycle count per call since the last reset. The tree is printed under the
+ * "cycles" terminal header; "cycles reset" clears it.
+ *
+ * Scopes past `MAX_SCOPES` or nested deeper than `MAX_DEPTH` are not counted, but still nest
+ * correctly. Scopes must be closed in the reverse order they were opened, which
+ * `CycleProfileScope` and the macros below guarantee.
+ */
+class CycleProfiler : public tap::communication::serial::TerminalSerialCallbackInterface
+{
+public:
+    static constexpr uint8_t MAX_SCOPES = 32;
+    static constexpr uint8_t MAX_DEPTH = 8;
+    /// Returned by `push` for a scope that is not being counted.
+    static constexpr uint8_t UNCOUNTED = UINT8_MAX;
+
+    CycleProfiler(Drivers &drivers);
+
+    /**
+     * Registers the "cycles" terminal header. The cycle counter must already be initialized.
+     */
+    void init();
+
+    /**
+     * Opens a scope nested in the innermost open one.
+     *
+     * @param[in] name the scope's name. Must outlive the profiler.
+     * @return the scope's index, to pass to `pop`.
+     */
+    uint8_t push(const char *name);
+
+    /**
+     * Closes the innermost open scope, which `push` returned `scope` for.
+     */
+    void pop(uint8_t scope);
+
+    /**
+     * Forgets every scope's statistics.
+     */
+    void reset();
+
+    bool terminalSerialCallback(
+        char *inputLine,
+        modm::IOStream &outputStream,
+        bool streamingEnabled) override;
+
+    void terminalSerialStreamCallback(modm::IOStream &) override {}
+
+private:
+    static constexpr uint8_t NO_PARENT = UNCOUNTED - 1;
+
+    struct Scope
+    {
+        const char *name;
+        uint8_t parent;
+        uint32_t min;
+        uint32_t max;
+        uint64_t sum;
+        uint32_t count;
+    };
+
+    struct OpenScope
+    {
+        uint8_t scope;
+        uint32_t startCycles;
+    };
+
+    uint8_t findOrAddScope(const char *name, uint8_t parent);
+
+    void printChildren(modm::IOStream &outputStream, uint8_t parent, uint8_t depth) const;
+
+    Drivers &drivers;
+
+    std::array<Scope, MAX_SCOPES> scopes{};
+    uint8_t numScopes{0};
+
+    std::array<OpenScope, MAX_DEPTH> openScopes{};
+    /// Open scopes, including uncounted ones past `MAX_DEPTH`.
+    uint8_t depth{0};
+};
+
+/**
+ * Counts the cycles from its construction to its destruction as a scope of `profiler`.
+ */
+class CycleProfileScope
+{
+public:
+    CycleProfileScope(CycleProfiler &profiler, const char *name)
+        : profiler(profiler),
+          scope(profiler.push(name))
+    {
+    }
+
+    ~CycleProfileScope() { profiler.pop(scope); }
+
+    CycleProfileScope(const CycleProfileScope &) = delete;
+    CycleProfileScope &operator=(const CycleProfileScope &) = delete;
+
+private:
+    CycleProfiler &profiler;
+    const uint8_t scope;
+};
+}  // namespace diagnostics
+
+#define CYCLE_PROFILE_CONCAT_INNER(a, b) a##b
+#define CYCLE_PROFILE_CONCAT(a, b) CYCLE_PROFILE_CONCAT_INNER(a, b)
+
+/**
+ * Counts the rest of the enclosing block as a scope named `name` of `profiler`.
+ */
+#define CYCLE_PROFILE_SCOPE(profiler, name) \
+    diagnostics::CycleProfileScope CYCLE_PROFILE_CONCAT(cycleProfileScope, __LINE__)(profiler, name)
+
+/**
+ * Calls `func params` as a scope of `profiler` named after `func`. Drop-in for taproot's PROFILE.
+ */
+#define CYCLE_PROFILE(profiler, func, params)                               \
+    do                                                                      \
+    {                                                                       \
+        diagnostics::CycleProfileScope cycleProfileScope(profiler, #func); \
+        func params;                                                        \
+    } while (0)
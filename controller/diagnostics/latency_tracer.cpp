@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "latency_tracer.hpp"
+
+#include <algorithm>
+
+#include "drivers.hpp"
+
+namespace diagnostics
+{
+LatencyTracer::LatencyTracer(Drivers &drivers) : drivers(drivers) {}
+
+void LatencyTracer::init() { drivers.terminalSerial.addHeader("latency", this); }
+
+void LatencyTracer::stampInput(LatencyInput input, uint32_t producedUs)
+{
+    uint8_t i = static_cast<uint8_t>(input);
+    stamps[i] = producedUs;
+    stamped[i] = true;
+}
+
+void LatencyTracer::endTick(uint32_t sentUs, bool motorFrameSent)
+{
+    if (!motorFrameSent)
+    {
+        unsentTicks++;
+    }
+
+    for (uint8_t i = 0; i < NUM_INPUTS; i++)
+    {
+        if (!stamped[i] || !motorFrameSent)
+        {
+            stamped[i] = false;
+            continue;
+        }
+
+        uint32_t latency = sentUs - stamps[i];
+        Statistics &stats = window[i];
+        stats.min = std::min(stats.min, latency);
+        stats.max = std::max(stats.max, latency);
+        stats.sum += latency;
+        stats.count++;
+        stamped[i] = false;
+    }
+
+    if (++ticksInWindow >= WINDOW_TICKS)
+    {
+        lastWindow = window;
+        window = {};
+        ticksInWindow = 0;
+        lastUnsentTicks = unsentTicks;
+        unsentTicks = 0;
+    }
+}
+
+bool LatencyTracer::terminalSerialCallback(char *, modm::IOStream &outputStream, bool)
+{
+    outputStream << "input to CAN TX latency over the last " << WINDOW_TICKS << " ticks (us):"
+                 << modm::endl;
+
+    for (uint8_t i = 0; i < NUM_INPUTS; i++)
+    {
+        const Statistics &stats = lastWindow[i];
+        outputStream << INPUT_NAMES[i] << ": ";
+
+        if (stats.count == 0)
+        {
+            outputStream << "no samples" << modm::endl;
+            continue;
+        }
+
+        outputStream << "min " << stats.min << ", mean "
+                     << static_cast<uint32_t>(stats.sum / stats.count) << ", max " << stats.max
+                     << " (" << stats.count << " samples)" << modm::endl;
+    }
+
+    outputStream << lastUnsentTicks << " ticks sent no motor frame and were not measured"
+                 << modm::endl;
+    return true;
+}
+}  // namespace diagnostics
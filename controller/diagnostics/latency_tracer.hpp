@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "tap/communication/serial/terminal_serial.hpp"
+
+class Drivers;
+
+namespace diagnostics
+{
+/// Inputs whose age is measured when the motor command built from them goes out on the bus.
+enum class LatencyInput : uint8_t
+{
+    REMOTE = 0,      ///< Remote frame arrival
+    IMU,             ///< IMU sample used for field-oriented drive
+    MOTOR_FEEDBACK,  ///< Oldest wheel feedback frame used by the chassis PID
+    NUM_INPUTS,
+};
+
+/**
+ * @brief Measures how old each input to a control tick is by the time the resulting CAN frame is
+ * sent.
+ *
+ * During a tick, whoever consumes an input stamps the time that input was produced. When the CAN
+ * frames go out, `endTick` turns every stamp into a latency and folds it into statistics over a
+ * window of `WINDOW_TICKS` ticks. Ticks whose motor frames were all held back as unchanged send
+ * nothing built from their inputs, so their stamps are discarded rather than measured. The last
+ * complete window is printed under the "latency" terminal header.
+ */
+class LatencyTracer : public tap::communication::serial::TerminalSerialCallbackInterface
+{
+public:
+    static constexpr uint16_t WINDOW_TICKS = 500;
+
+    LatencyTracer(Drivers &drivers);
+
+    /**
+     * Registers the "latency" terminal header.
+     */
+    void init();
+
+    /**
+     * Records the time an input consumed during the current tick was produced.
+     */
+    void stampInput(LatencyInput input, uint32_t producedUs);
+
+    /**
+     * Closes the current tick. Call right after the tick's CAN frames have been sent.
+     *
+     * @param[in] sentUs the time the CAN frames were sent, in microseconds.
+     * @param[in] motorFrameSent whether a motor frame carrying this tick's setpoints went out. If
+     *      not, the tick's stamps are discarded.
+     */
+    void endTick(uint32_t sentUs, bool motorFrameSent);
+
+    bool terminalSerialCallback(
+        char *inputLine,
+        modm::IOStream &outputStream,
+        bool streamingEnabled) override;
+
+    void terminalSerialStreamCallback(modm::IOStream &) override {}
+
+private:
+    static constexpr uint8_t NUM_INPUTS = static_cast<uint8_t>(LatencyInput::NUM_INPUTS);
+    static constexpr const char *INPUT_NAMES[NUM_INPUTS] = {"remote", "imu", "motor feedback"};
+
+    struct Statistics
+    {
+        uint32_t min{UINT32_MAX};
+        uint32_t max{0};
+        uint64_t sum{0};
+        uint32_t count{0};
+    };
+
+    Drivers &drivers;
+
+    std::array<uint32_t, NUM_INPUTS> stamps{};
+    std::array<bool, NUM_INPUTS> stamped{};
+
+    std::array<Statistics, NUM_INPUTS> window{};
+    std::array<Statistics, NUM_INPUTS> lastWindow{};
+    uint16_t ticksInWindow{0};
+    /// Ticks in the window, and in the last complete one, that sent no motor frame.
+    uint16_t unsentTicks{0};
+    uint16_t lastUnsentTicks{0};
+};
+}  // namespace diagnostics
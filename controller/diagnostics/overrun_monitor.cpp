@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "overrun_monitor.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "tap/errors/create_errors.hpp"
+
+#include "drivers.hpp"
+
+namespace diagnostics
+{
+OverrunMonitor::OverrunMonitor(Drivers &drivers, const OverrunMonitorConfig &config)
+    : drivers(drivers),
+      config(config)
+{
+}
+
+void OverrunMonitor::init() { drivers.terminalSerial.addHeader("overrun", this); }
+
+void OverrunMonitor::checkTick(uint32_t lateUs)
+{
+    maxLateUs = std::max(maxLateUs, lateUs);
+
+    if (windowTick == config.windowTicks)
+    {
+        windowTick = 0;
+        windowOverruns = 0;
+    }
+    windowTick++;
+
+    if (lateUs > config.lateBudgetUs)
+    {
+        overrunCount++;
+        windowOverruns++;
+        lastOverrunUs = lateUs;
+    }
+
+    if (!shedding)
+    {
+        if (windowOverruns >= config.shedOverruns)
+        {
+            setShedding(true);
+        }
+        return;
+    }
+
+    calmTicks = lateUs <= config.recoverLateBudgetUs ? calmTicks + 1 : 0;
+    if (calmTicks >= config.recoverTicks)
+    {
+        setShedding(false);
+        return;
+    }
+
+    nonCriticalWorkDue = ++ticksSinceService >= config.shedServicePeriodTicks;
+    if (nonCriticalWorkDue)
+    {
+        ticksSinceService = 0;
+    }
+}
+
+void OverrunMonitor::setShedding(bool enabled)
+{
+    shedding = enabled;
+    nonCriticalWorkDue = !enabled;
+    calmTicks = 0;
+    ticksSinceService = 0;
+    windowTick = 0;
+    windowOverruns = 0;
+
+    if (enabled)
+    {
+        shedCount++;
+        drivers.traceBuffer.setRecording(false);
+        RAISE_ERROR((&drivers), "control ticks started late, shedding non-critical work");
+    }
+}
+
+bool OverrunMonitor::terminalSerialCallback(char *inputLine, modm::IOStream &outputStream, bool)
+{
+    if (inputLine != nullptr && std::strstr(inputLine, "reset") != nullptr)
+    {
+        overrunCount = 0;
+        shedCount = 0;
+        maxLateUs = 0;
+        lastOverrunUs = 0;
+        outputStream << "overrun counts reset" << modm::endl;
+        return true;
+    }
+
+    outputStream << (shedding ? "shedding non-critical work" : "ok") << ", shed " << shedCount
+                 << " times" << modm::endl;
+    outputStream << "overruns " << overrunCount << ", last " << lastOverrunUs << " us late, max "
+                 << maxLateUs << " us late of " << config.lateBudgetUs << " us allowed"
+                 << modm::endl;
+    return true;
+}
+}  // namespace diagnostics
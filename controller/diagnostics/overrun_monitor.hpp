@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "tap/communication/serial/terminal_serial.hpp"
+
+class Drivers;
+
+namespace diagnostics
+{
+/// Thresholds, to be set by the user.
+struct OverrunMonitorConfig
+{
+    /// Time a control tick may start after its deadline. Anything in the main loop that runs
+    /// long, including the work that is shed, delays the next tick past this.
+    const uint32_t lateBudgetUs{200};
+    /// Overruns within `windowTicks` ticks after which non-critical work is shed.
+    const uint16_t shedOverruns{3};
+    const uint16_t windowTicks{500};
+    /// While shedding, ticks must start within this of their deadline for `recoverTicks` ticks in
+    /// a row before non-critical work resumes. Below `lateBudgetUs`, so a loop running at the edge
+    /// does not flap.
+    const uint32_t recoverLateBudgetUs{100};
+    const uint16_t recoverTicks{500};
+    /// While shedding, non-critical work still runs once every this many ticks, so the terminal
+    /// stays reachable.
+    const uint16_t shedServicePeriodTicks{50};
+};
+
+/**
+ * @brief Counts control ticks that started late, and sheds non-critical work once they are late
+ * too often, so chassis and gimbal control keep their rate.
+ *
+ * A tick is measured against the deadline the control tick timer set for it, so everything the
+ * main loop ran since the previous tick counts: that tick's own work, input updates and the work
+ * that is shed.
+ *
+ * Once `shedOverruns` overruns happen within a window of `windowTicks`, an error is raised, the
+ * trace buffer is stopped so it keeps the ticks that led up to the overruns, and
+ * `isNonCriticalWorkDue` is false on all but one in `shedServicePeriodTicks` ticks. The main loop
+ * then skips the terminal update. Referee serial RX is not shed, so no referee data is lost.
+ * Normal operation resumes after `recoverTicks` ticks in a row within `recoverLateBudgetUs`.
+ *
+ * Overrun counts are printed under the "overrun" terminal header; "overrun reset" clears them.
+ */
+class OverrunMonitor : public tap::communication::serial::TerminalSerialCallbackInterface
+{
+public:
+    OverrunMonitor(Drivers &drivers, const OverrunMonitorConfig &config);
+
+    /**
+     * Registers the "overrun" terminal header.
+     */
+    void init();
+
+    /**
+     * Checks one control tick. Call once per tick, as it starts.
+     *
+     * @param[in] lateUs how long after its deadline the tick started, in microseconds.
+     */
+    void checkTick(uint32_t lateUs);
+
+    /**
+     * @return whether non-critical work is being shed.
+     */
+    bool isShedding() const { return shedding; }
+
+    /**
+     * @return whether non-critical work should run until the next tick.
+     */
+    bool isNonCriticalWorkDue() const { return nonCriticalWorkDue; }
+
+    bool terminalSerialCallback(
+        char *inputLine,
+        modm::IOStream &outputStream,
+        bool streamingEnabled) override;
+
+    void terminalSerialStreamCallback(modm::IOStream &) override {}
+
+private:
+    void setShedding(bool enabled);
+
+    Drivers &drivers;
+    const OverrunMonitorConfig &config;
+
+    bool shedding{false};
+    bool nonCriticalWorkDue{true};
+
+    uint16_t windowTick{0};
+    uint16_t windowOverruns{0};
+    /// While shedding, ticks in a row within `recoverLateBudgetUs`.
+    uint16_t calmTicks{0};
+    /// While shedding, ticks since non-critical work last ran.
+    uint16_t ticksSinceService{0};
+
+    uint32_t overrunCount{0};
+    uint32_t shedCount{0};
+    uint32_t maxLateUs{0};
+    uint32_t lastOverrunUs{0};
+};
+}  // namespace diagnostics
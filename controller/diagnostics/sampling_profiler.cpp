@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifdef ENABLE_SAMPLING_PROFILER
+
+#include "sampling_profiler.hpp"
+
+#include <bit>
+#include <cstring>
+
+#ifdef PLATFORM_HOSTED
+#include <csignal>
+#include <sys/time.h>
+#include <ucontext.h>
+#else
+#include "modm/platform/device.hpp"
+#endif
+
+#include "drivers.hpp"
+
+namespace diagnostics
+{
+/// The profiler the sampling interrupt records into.
+static SamplingProfiler *activeProfiler = nullptr;
+}  // namespace diagnostics
+
+#ifdef PLATFORM_HOSTED
+/// Start of the executable's image, to turn sampled addresses into ELF addresses.
+extern "C" char __executable_start;
+
+static void takeSample(int, siginfo_t *, void *context)
+{
+    const mcontext_t &registers = static_cast<ucontext_t *>(context)->uc_mcontext;
+#if defined(__x86_64__)
+    // x86 keeps return addresses on the stack only, so there is no LR to sample
+    diagnostics::activeProfiler->recordSample(registers.gregs[REG_RIP], 0);
+#elif defined(__aarch64__)
+    diagnostics::activeProfiler->recordSample(registers.pc, registers.regs[30]);
+#else
+    (void)registers;
+#endif
+}
+#else
+/// APB1 timer clock of the RoboMaster development board type A, which clocks TIM7.
+static constexpr uint32_t TIM7_CLOCK_HZ = 90'000'000;
+/// High enough to preempt, and so sample, most other interrupt handlers.
+static constexpr uint32_t TIM7_INTERRUPT_PRIORITY = 2;
+
+/**
+ * Takes a sample from the exception frame the interrupted code stacked: r0-r3, r12, LR, PC, xPSR.
+ */
+extern "C" void samplingProfilerTakeSample(const uint32_t *exceptionFrame)
+{
+    TIM7->SR = ~TIM_SR_UIF;
+    diagnostics::activeProfiler->recordSample(exceptionFrame[6], exceptionFrame[5]);
+}
+
+/**
+ * Finds the exception frame on whichever stack the interrupted code was using and tail calls
+ * samplingProfilerTakeSample with it. Naked, so that no stack frame of its own moves it.
+ */
+extern "C" __attribute__((naked)) void TIM7_IRQHandler()
+{
+    asm volatile(
+        "tst lr, #4\n"
+        "ite eq\n"
+        "mrseq r0, msp\n"
+        "mrsne r0, psp\n"
+        "b samplingProfilerTakeSample\n");
+}
+#endif
+
+namespace diagnostics
+{
+static constexpr int HASH_SHIFT = 32 - std::countr_zero(SamplingProfiler::HISTOGRAM_SIZE);
+/// Bins probed past an address' hash before its sample is dropped.
+static constexpr uint16_t MAX_PROBES = 16;
+
+SamplingProfiler::SamplingProfiler(Drivers &drivers) : drivers(drivers) {}
+
+void SamplingProfiler::init()
+{
+    drivers.terminalSerial.addHeader("samples", this);
+    activeProfiler = this;
+    sampling = true;
+    startTimer();
+}
+
+void SamplingProfiler::recordSample(uintptr_t pc, uintptr_t lr)
+{
+    if (!sampling)
+    {
+        return;
+    }
+
+    totalSamples++;
+    if (!insert(pcHistogram, pc))
+    {
+        droppedSamples++;
+    }
+    if (lr != 0)
+    {
+        insert(lrHistogram, lr);
+    }
+}
+
+bool SamplingProfiler::insert(Histogram &histogram, uintptr_t address)
+{
+    // Fibonacci hashing of the halfword address
+    uint32_t hash = static_cast<uint32_t>(address >> 1) * 2'654'435'769u >> HASH_SHIFT;
+
+    for (uint16_t probe = 0; probe < MAX_PROBES; probe++)
+    {
+        Bin &bin = histogram[(hash + probe) & (HISTOGRAM_SIZE - 1)];
+        if (bin.count == 0)
+        {
+            bin.address = address;
+        }
+        if (bin.address == address)
+        {
+            bin.count++;
+            return true;
+        }
+    }
+    return false;
+}
+
+void SamplingProfiler::startTimer()
+{
+#ifdef PLATFORM_HOSTED
+    struct sigaction action = {};
+    action.sa_sigaction = takeSample;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGPROF, &action, nullptr);
+
+    itimerval interval = {};
+    interval.it_interval.tv_usec = SAMPLE_PERIOD_US;
+    interval.it_value.tv_usec = SAMPLE_PERIOD_US;
+    setitimer(ITIMER_PROF, &interval, nullptr);
+#else
+    RCC->APB1ENR |= RCC_APB1ENR_TIM7EN;
+    __DSB();
+
+    // Count microseconds, updating once per sample period
+    TIM7->PSC = TIM7_CLOCK_HZ / 1'000'000 - 1;
+    TIM7->ARR = SAMPLE_PERIOD_US - 1;
+    TIM7->EGR = TIM_EGR_UG;
+    TIM7->SR = 0;
+    TIM7->DIER = TIM_DIER_UIE;
+
+    NVIC_SetPriority(TIM7_IRQn, TIM7_INTERRUPT_PRIORITY);
+    NVIC_EnableIRQ(TIM7_IRQn);
+    TIM7->CR1 = TIM_CR1_CEN;
+#endif
+}
+
+void SamplingProfiler::reset()
+{
+    pcHistogram = {};
+    lrHistogram = {};
+    totalSamples = 0;
+    droppedSamples = 0;
+}
+
+static void printHex(modm::IOStream &outputStream, uintptr_t value)
+{
+    char text[2 * sizeof(uintptr_t) + 3] = "0x";
+    for (size_t ii = 0; ii < 2 * sizeof(uintptr_t); ii++)
+    {
+        text[2 + ii] = "0123456789abcdef"[(value >> (4 * (2 * sizeof(uintptr_t) - 1 - ii))) & 0xf];
+    }
+    text[sizeof(text) - 1] = '\0';
+    outputStream << text;
+}
+
+void SamplingProfiler::printHistogram(
+    modm::IOStream &outputStream,
+    const char *label,
+    const Histogram &histogram)
+{
+    for (const Bin &bin : histogram)
+    {
+        if (bin.count == 0)
+        {
+            continue;
+        }
+        outputStream << label << " ";
+        printHex(outputStream, bin.address);
+        outputStream << " " << bin.count << modm::endl;
+    }
+}
+
+bool SamplingProfiler::terminalSerialCallback(char *inputLine, modm::IOStream &outputStream, bool)
+{
+    bool wasSampling = sampling;
+    sampling = false;
+
+    if (inputLine != nullptr && std::strstr(inputLine, "reset") != nullptr)
+    {
+        reset();
+        outputStream << "samples reset" << modm::endl;
+    }
+    else if (inputLine != nullptr && std::strstr(inputLine, "stop") != nullptr)
+    {
+        wasSampling = false;
+        outputStream << "sampling stopped" << modm::endl;
+    }
+    else if (inputLine != nullptr && std::strstr(inputLine, "start") != nullptr)
+    {
+        wasSampling = true;
+        outputStream << "sampling started" << modm::endl;
+    }
+    else
+    {
+        outputStream << "samples " << totalSamples << " dropped " << droppedSamples
+                     << " period_us " << SAMPLE_PERIOD_US << modm::endl;
+        outputStream << "base ";
+#ifdef PLATFORM_HOSTED
+        printHex(outputStream, reinterpret_cast<uintptr_t>(&__executable_start));
+#else
+        printHex(outputStream, 0);
+#endif
+        outputStream << modm::endl;
+        printHistogram(outputStream, "pc", pcHistogram);
+        printHistogram(outputStream, "lr", lrHistogram);
+        outputStream << "end" << modm::endl;
+    }
+
+    sampling = wasSampling;
+    return true;
+}
+}  // namespace diagnostics
+
+#endif  // ENABLE_SAMPLING_PROFILER
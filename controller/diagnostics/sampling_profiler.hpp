@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "tap/communication/serial/terminal_serial.hpp"
+
+class Drivers;
+
+namespace diagnostics
+{
+/**
+ * @brief Statistical profiler: histograms of the program counter, and link register, sampled at
+ * a fixed rate from an interrupt.
+ *
+ * On the board a spare basic timer, TIM7, interrupts every `SAMPLE_PERIOD_US` and the handler
+ * reads the PC and LR the hardware stacked on entry. SysTick is left to modm's clock. Hosted
+ * builds sample the same way from SIGPROF, which fires per CPU time used.
+ *
+ * The PC histogram shows where time is spent. LR is the caller of a leaf function, or of any
+ * function that has not yet reused LR, which is usually enough to tell which caller of a shared
+ * function is the busy one.
+ *
+ * Each histogram is a fixed-size open addressing hash table, so recording a sample costs a few
+ * dozen cycles and never allocates. Samples whose address finds no free bin are counted as
+ * dropped.
+ *
+ * The histograms are printed under the "samples" terminal header, as raw addresses for
+ * testing/symbolize_samples.py to resolve against the firmware ELF. "samples reset" clears them,
+ * "samples stop" and "samples start" pause and resume sampling.
+ *
+ * Only built with ENABLE_SAMPLING_PROFILER defined (`scons build sampling_profiler=1`).
+ */
+class SamplingProfiler : public tap::communication::serial::TerminalSerialCallbackInterface
+{
+public:
+    /// Deliberately not a divisor of the control period, so sampling does not alias with it.
+    static constexpr uint32_t SAMPLE_PERIOD_US = 197;
+    /// Bins per histogram. Must be a power of two.
+    static constexpr uint16_t HISTOGRAM_SIZE = 512;
+
+    SamplingProfiler(Drivers &drivers);
+
+    /**
+     * Registers the "samples" terminal header and starts sampling.
+     */
+    void init();
+
+    /**
+     * Adds one sample. Called from the sampling interrupt.
+     */
+    void recordSample(uintptr_t pc, uintptr_t lr);
+
+    bool terminalSerialCallback(
+        char *inputLine,
+        modm::IOStream &outputStream,
+        bool streamingEnabled) override;
+
+    void terminalSerialStreamCallback(modm::IOStream &) override {}
+
+private:
+    struct Bin
+    {
+        uintptr_t address;
+        uint32_t count;
+    };
+
+    using Histogram = std::array<Bin, HISTOGRAM_SIZE>;
+
+    /// @return whether `address` was counted.
+    static bool insert(Histogram &histogram, uintptr_t address);
+
+    static void printHistogram(
+        modm::IOStream &outputStream,
+        const char *label,
+        const Histogram &histogram);
+
+    void startTimer();
+
+    void reset();
+
+    Drivers &drivers;
+
+    Histogram pcHistogram{};
+    Histogram lrHistogram{};
+    uint32_t totalSamples{0};
+    uint32_t droppedSamples{0};
+
+    /// Cleared while the histograms are printed or reset, so they are not written meanwhile.
+    volatile bool sampling{false};
+};
+}  // namespace diagnostics
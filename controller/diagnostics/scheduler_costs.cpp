@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "scheduler_costs.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "architecture/robot_loop.hpp"
+
+#include "drivers.hpp"
+
+using architecture::RobotLoop;
+
+namespace diagnostics
+{
+SchedulerCosts::SchedulerCosts(Drivers &drivers) : drivers(drivers) {}
+
+void SchedulerCosts::init() { drivers.terminalSerial.addHeader("scheduler", this); }
+
+uint8_t SchedulerCosts::findOrAdd(tap::control::Subsystem *subsystem)
+{
+    return findOrAdd(subsystem, subsystem->getName(), false);
+}
+
+uint8_t SchedulerCosts::findOrAdd(const tap::control::Command *command)
+{
+    return findOrAdd(command, command->getName(), true);
+}
+
+uint8_t SchedulerCosts::findOrAdd(const void *owner, const char *name, bool isCommand)
+{
+    for (uint8_t ii = 0; ii < numEntries; ii++)
+    {
+        if (entries[ii].owner == owner)
+        {
+            return ii;
+        }
+    }
+
+    if (numEntries == MAX_ENTRIES)
+    {
+        return UNACCOUNTED;
+    }
+
+    entries[numEntries] =
+        Entry{owner, name, drivers.traceBuffer.registerName(name), isCommand, 0, 0, 0};
+    return numEntries++;
+}
+
+uint32_t SchedulerCosts::begin(uint8_t entry)
+{
+    if (entry != UNACCOUNTED)
+    {
+        drivers.traceBuffer.record(entries[entry].traceNameId, TraceBuffer::Phase::BEGIN);
+    }
+    return architecture::cycle_counter::read();
+}
+
+void SchedulerCosts::end(uint8_t entry, uint32_t startCycles)
+{
+    uint32_t cycles = architecture::cycle_counter::read() - startCycles;
+
+    if (entry == UNACCOUNTED)
+    {
+        return;
+    }
+
+    Entry &costs = entries[entry];
+    drivers.traceBuffer.record(costs.traceNameId, TraceBuffer::Phase::END);
+    costs.max = std::max(costs.max, cycles);
+    costs.sum += cycles;
+    costs.count++;
+}
+
+void SchedulerCosts::reset()
+{
+    for (uint8_t ii = 0; ii < numEntries; ii++)
+    {
+        entries[ii].max = 0;
+        entries[ii].sum = 0;
+        entries[ii].count = 0;
+    }
+}
+
+bool SchedulerCosts::terminalSerialCallback(
+    char *inputLine,
+    modm::IOStream &outputStream,
+    bool streamingEnabled)
+{
+    if (inputLine == nullptr || std::strstr(inputLine, "costs") == nullptr)
+    {
+        return drivers.schedulerTerminalHandler.terminalSerialCallback(
+            inputLine,
+            outputStream,
+            streamingEnabled);
+    }
+
+    if (std::strstr(inputLine, "reset") != nullptr)
+    {
+        reset();
+        outputStream << "scheduler costs reset" << modm::endl;
+    }
+    else
+    {
+        printCosts(outputStream);
+    }
+    return true;
+}
+
+void SchedulerCosts::terminalSerialStreamCallback(modm::IOStream &outputStream)
+{
+    drivers.schedulerTerminalHandler.terminalSerialStreamCallback(outputStream);
+}
+
+void SchedulerCosts::printCosts(modm::IOStream &outputStream) const
+{
+    outputStream << "cost per call since reset, of a " << RobotLoop::CONTROL_PERIOD_US
+                 << " us tick (mean / max cycles, mean ns, share of tick):" << modm::endl;
+
+    outputStream << "subsystem refresh:" << modm::endl;
+    uint32_t meanCycles = printEntries(outputStream, false);
+    outputStream << "command execute:" << modm::endl;
+    meanCycles += printEntries(outputStream, true);
+
+    outputStream << "total ";
+    printShare(outputStream, meanCycles);
+    outputStream << modm::endl;
+}
+
+uint32_t SchedulerCosts::printEntries(modm::IOStream &outputStream, bool commands) const
+{
+    uint32_t meanCycles = 0;
+    for (uint8_t ii = 0; ii < numEntries; ii++)
+    {
+        const Entry &costs = entries[ii];
+        if (costs.isCommand != commands)
+        {
+            continue;
+        }
+
+        outputStream << "  " << costs.name << ": ";
+        if (costs.count == 0)
+        {
+            outputStream << "no calls" << modm::endl;
+            continue;
+        }
+
+        uint32_t mean = static_cast<uint32_t>(costs.sum / costs.count);
+        meanCycles += mean;
+        outputStream << mean << " / " << costs.max << ", ";
+        printShare(outputStream, mean);
+        outputStream << " (" << costs.count << " calls)" << modm::endl;
+    }
+    return meanCycles;
+}
+
+void SchedulerCosts::printShare(modm::IOStream &outputStream, uint32_t cycles)
+{
+    uint32_t ns = architecture::cycle_counter::toNanoseconds(cycles);
+    // Tenths of a percent of the tick
+    uint32_t permille = ns / RobotLoop::CONTROL_PERIOD_US;
+    outputStream << ns << " ns, " << permille / 10 << "." << permille % 10 << "%";
+}
+}  // namespace diagnostics
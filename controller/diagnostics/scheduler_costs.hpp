@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "tap/communication/serial/terminal_serial.hpp"
+
+#include "architecture/cycle_counter.hpp"
+
+class Drivers;
+
+namespace tap::control
+{
+class Command;
+class Subsystem;
+}  // namespace tap::control
+
+namespace diagnostics
+{
+/**
+ * @brief Accounts the cycles spent in each subsystem's refresh and each command's execute, so every
+ * subsystem and command added shows what it costs of the control tick.
+ *
+ * Taproot's CommandScheduler cannot be hooked, so each refresh and execute opens a
+ * `SCHEDULER_COST_SCOPE` itself. Entries are kept per instance, and the scope also traces the call
+ * into the trace buffer under that instance's name, so instances of one class need distinct names
+ * to be told apart.
+ *
+ * The costs are printed by "scheduler costs", and "scheduler costs reset" clears them. Init
+ * registers this in place of taproot's SchedulerTerminalHandler, and every other "scheduler"
+ * command is passed on to it unchanged.
+ */
+class SchedulerCosts : public tap::communication::serial::TerminalSerialCallbackInterface
+{
+public:
+    /// Subsystems and commands accounted and traced; any past this are neither.
+    static constexpr uint8_t MAX_ENTRIES = 16;
+    /// Returned by `findOrAdd` once `MAX_ENTRIES` are accounted.
+    static constexpr uint8_t UNACCOUNTED = UINT8_MAX;
+
+    SchedulerCosts(Drivers &drivers);
+
+    /**
+     * Registers the "scheduler" terminal header. Call instead of the scheduler terminal handler's
+     * init. The cycle counter must already be initialized.
+     */
+    void init();
+
+    /**
+     * @return the entry accounting `subsystem`'s refresh, added and its name registered with the
+     * trace buffer if it is new. The name must outlive the trace buffer.
+     */
+    uint8_t findOrAdd(tap::control::Subsystem *subsystem);
+
+    /**
+     * @return the entry accounting `command`'s execute, added and its name registered with the
+     * trace buffer if it is new. The name must outlive the trace buffer.
+     */
+    uint8_t findOrAdd(const tap::control::Command *command);
+
+    /**
+     * Starts a call of `entry`.
+     *
+     * @return the cycle counter at the start, to pass to `end`.
+     */
+    uint32_t begin(uint8_t entry);
+
+    /**
+     * Ends the call of `entry` that `begin` returned `startCycles` for.
+     */
+    void end(uint8_t entry, uint32_t startCycles);
+
+    /**
+     * Forgets every entry's costs.
+     */
+    void reset();
+
+    bool terminalSerialCallback(
+        char *inputLine,
+        modm::IOStream &outputStream,
+        bool streamingEnabled) override;
+
+    void terminalSerialStreamCallback(modm::IOStream &outputStream) override;
+
+private:
+    struct Entry
+    {
+        const void *owner;
+        const char *name;
+        uint16_t traceNameId;
+        bool isCommand;
+        uint32_t max;
+        uint64_t sum;
+        uint32_t count;
+    };
+
+    uint8_t findOrAdd(const void *owner, const char *name, bool isCommand);
+
+    void printCosts(modm::IOStream &outputStream) const;
+
+    /**
+     * Prints the entries that are commands if `commands` is set, otherwise the subsystems.
+     *
+     * @return the sum of the printed entries' mean cycles per call.
+     */
+    uint32_t printEntries(modm::IOStream &outputStream, bool commands) const;
+
+    /**
+     * Prints `cycles` in ns and as a share of the control tick.
+     */
+    static void printShare(modm::IOStream &outputStream, uint32_t cycles);
+
+    Drivers &drivers;
+
+    std::array<Entry, MAX_ENTRIES> entries{};
+    uint8_t numEntries{0};
+};
+
+/**
+ * Accounts the cycles from its construction to its destruction to `entry` of `costs`.
+ */
+class SchedulerCostScope
+{
+public:
+    SchedulerCostScope(SchedulerCosts &costs, uint8_t entry)
+        : costs(costs),
+          entry(entry),
+          startCycles(costs.begin(entry))
+    {
+    }
+
+    ~SchedulerCostScope() { costs.end(entry, startCycles); }
+
+    SchedulerCostScope(const SchedulerCostScope &) = delete;
+    SchedulerCostScope &operator=(const SchedulerCostScope &) = delete;
+
+private:
+    SchedulerCosts &costs;
+    const uint8_t entry;
+    const uint32_t startCycles;
+};
+}  // namespace diagnostics
+
+/**
+ * Accounts the rest of the enclosing refresh or execute to the subsystem or command instance it
+ * belongs to, and traces it under its name. Only usable in a member function of a Subsystem or
+ * Command.
+ */
+#define SCHEDULER_COST_SCOPE(costs) \
+    diagnostics::SchedulerCostScope schedulerCostScope(costs, (costs).findOrAdd(this))
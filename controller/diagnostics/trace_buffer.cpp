@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "trace_buffer.hpp"
+
+#include <cstring>
+
+#include "drivers.hpp"
+
+namespace diagnostics
+{
+TraceBuffer::TraceBuffer(Drivers &drivers) : drivers(drivers) {}
+
+void TraceBuffer::init() { drivers.terminalSerial.addHeader("trace", this); }
+
+uint16_t TraceBuffer::registerName(const char *name)
+{
+    for (uint16_t ii = 0; ii < numNames; ii++)
+    {
+        if (names[ii] == name || std::strcmp(names[ii], name) == 0)
+        {
+            return ii;
+        }
+    }
+
+    if (numNames == MAX_NAMES)
+    {
+        return UNNAMED;
+    }
+
+    names[numNames] = name;
+    return numNames++;
+}
+
+void TraceBuffer::reset()
+{
+    head = 0;
+    count = 0;
+}
+
+bool TraceBuffer::terminalSerialCallback(char *inputLine, modm::IOStream &outputStream, bool)
+{
+    if (inputLine != nullptr && std::strstr(inputLine, "reset") != nullptr)
+    {
+        reset();
+        outputStream << "trace reset" << modm::endl;
+    }
+    else if (inputLine != nullptr && std::strstr(inputLine, "stop") != nullptr)
+    {
+        recording = false;
+        outputStream << "trace stopped" << modm::endl;
+    }
+    else if (inputLine != nullptr && std::strstr(inputLine, "start") != nullptr)
+    {
+        // Starting fresh keeps scopes left open by "trace stop" from spanning the pause
+        reset();
+        recording = true;
+        outputStream << "trace started" << modm::endl;
+    }
+    else
+    {
+        // Nothing is recorded while the dump runs, so the ring cannot move underneath it
+        bool wasRecording = recording;
+        recording = false;
+        dump(outputStream);
+        recording = wasRecording;
+    }
+    return true;
+}
+
+void TraceBuffer::dump(modm::IOStream &outputStream) const
+{
+    outputStream << "trace cycles_khz "
+                 << static_cast<uint32_t>(architecture::cycle_counter::getFrequencyHz() / 1'000)
+                 << " events " << count << " names " << numNames << modm::endl;
+
+    for (uint16_t ii = 0; ii < numNames; ii++)
+    {
+        outputStream << "name " << ii << " " << names[ii] << modm::endl;
+    }
+
+    uint16_t oldest = (head - count) & (CAPACITY - 1);
+    for (uint16_t ii = 0; ii < count; ii++)
+    {
+        const Event &event = events[(oldest + ii) & (CAPACITY - 1)];
+        outputStream << "e " << event.cycles << " " << event.nameId << " "
+                     << static_cast<char>(event.phase) << modm::endl;
+    }
+    outputStream << "end" << modm::endl;
+}
+}  // namespace diagnostics
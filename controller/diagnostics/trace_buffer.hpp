@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "tap/communication/serial/terminal_serial.hpp"
+
+#include "architecture/cycle_counter.hpp"
+
+class Drivers;
+
+namespace diagnostics
+{
+/**
+ * @brief Records begin and end events of named scopes of the main loop into a ring in RAM, so a
+ * timeline of the last few hundred control ticks can be dumped and inspected offline.
+ *
+ * Each event is 8 bytes: the cycle counter when it happened, the id of the scope's name and
+ * whether the scope began or ended. Once the ring is full the oldest events are overwritten.
+ *
+ * The ring is dumped under the "trace" terminal header, as
+ *
+ *     trace cycles_khz <kHz> events <count> names <count>
+ *     name <id> <name>
+ *     e <cycles> <id> <B|E>
+ *     end
+ *
+ * oldest event first. testing/trace_to_json.py converts a dump to Chrome trace JSON, which
+ * chrome://tracing and ui.perfetto.dev both open. "trace stop" freezes the ring, "trace start"
+ * clears it and records again and "trace reset" forgets every event.
+ */
+class TraceBuffer : public tap::communication::serial::TerminalSerialCallbackInterface
+{
+public:
+    /// Events kept, a power of two. At ~12 events per 2 ms tick this covers about a third of a
+    /// second.
+    static constexpr uint16_t CAPACITY = 2048;
+    static constexpr uint16_t MAX_NAMES = 64;
+    /// Returned by `registerName` once `MAX_NAMES` names are registered; never recorded.
+    static constexpr uint16_t UNNAMED = UINT16_MAX;
+
+    enum class Phase : uint8_t
+    {
+        BEGIN = 'B',
+        END = 'E',
+    };
+
+    TraceBuffer(Drivers &drivers);
+
+    /**
+     * Registers the "trace" terminal header. The cycle counter must already be initialized.
+     */
+    void init();
+
+    /**
+     * Looks up the id of a scope's name, adding it if it is new.
+     *
+     * @param[in] name the scope's name. Must outlive the buffer.
+     */
+    uint16_t registerName(const char *name);
+
+    inline void record(uint16_t nameId, Phase phase)
+    {
+        if (!recording || nameId == UNNAMED)
+        {
+            return;
+        }
+
+        events[head] = Event{architecture::cycle_counter::read(), nameId, phase, 0};
+        head = (head + 1) & (CAPACITY - 1);
+        if (count < CAPACITY)
+        {
+            count++;
+        }
+    }
+
+    /**
+     * Stops or resumes recording. Stopping keeps the events leading up to a fault for a later
+     * dump.
+     */
+    void setRecording(bool enabled) { recording = enabled; }
+
+    bool isRecording() const { return recording; }
+
+    /**
+     * Forgets every recorded event. Registered names are kept.
+     */
+    void reset();
+
+    bool terminalSerialCallback(
+        char *inputLine,
+        modm::IOStream &outputStream,
+        bool streamingEnabled) override;
+
+    void terminalSerialStreamCallback(modm::IOStream &) override {}
+
+private:
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+
+    struct Event
+    {
+        uint32_t cycles;
+        uint16_t nameId;
+        Phase phase;
+        uint8_t reserved;
+    };
+
+    static_assert(sizeof(Event) == 8);
+
+    void dump(modm::IOStream &outputStream) const;
+
+    Drivers &drivers;
+
+    std::array<Event, CAPACITY> events{};
+    /// Index the next event is written to.
+    uint16_t head{0};
+    uint16_t count{0};
+    bool recording{true};
+
+    std::array<const char *, MAX_NAMES> names{};
+    uint16_t numNames{0};
+};
+
+/**
+ * Records a begin event of `nameId` on construction and the matching end event on destruction.
+ */
+class TraceScope
+{
+public:
+    TraceScope(TraceBuffer &buffer, uint16_t nameId) : buffer(buffer), nameId(nameId)
+    {
+        buffer.record(nameId, TraceBuffer::Phase::BEGIN);
+    }
+
+    ~TraceScope() { buffer.record(nameId, TraceBuffer::Phase::END); }
+
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+
+private:
+    TraceBuffer &buffer;
+    const uint16_t nameId;
+};
+}  // namespace diagnostics
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+/**
+ * Traces the rest of the enclosing block as a scope named `name` of `buffer`. The name is
+ * registered the first time the line runs, so later calls only record the two events.
+ */
+#define TRACE_SCOPE(buffer, name)                                                   \
+    static const uint16_t TRACE_CONCAT(traceNameId, __LINE__) =                     \
+        (buffer).registerName(name);                                                \
+    diagnostics::TraceScope TRACE_CONCAT(traceScope, __LINE__)(                     \
+        buffer,                                                                     \
+        TRACE_CONCAT(traceNameId, __LINE__))
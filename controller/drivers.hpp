@@ -21,6 +21,18 @@
 
 #include "tap/drivers.hpp"
 
+#include "communication/can/can_tx_scheduler.hpp"
+#include "communication/can/socketcan_bridge.hpp"
+#include "communication/serial/virtual_remote.hpp"
+#include "control/imu/imu_pipeline.hpp"
+#include "control/remote_failsafe.hpp"
+#include "diagnostics/cycle_profiler.hpp"
+#include "diagnostics/latency_tracer.hpp"
+#include "diagnostics/overrun_monitor.hpp"
+#include "diagnostics/sampling_profiler.hpp"
+#include "diagnostics/scheduler_costs.hpp"
+#include "diagnostics/trace_buffer.hpp"
+
 #ifdef ENV_UNIT_TESTS
 #include "control/mock_control_operator_interface.hpp"
 #else
@@ -34,12 +46,57 @@ class Drivers : public tap::Drivers
 #ifdef ENV_UNIT_TESTS
 public:
 #endif
-    Drivers() : tap::Drivers(), controlOperatorInterface(remote, mpu6500) {}
+    Drivers()
+        : tap::Drivers(),
+#if defined(PLATFORM_HOSTED) && !defined(ENV_UNIT_TESTS)
+          socketCanBridge(*this),
+#endif
+          canTxScheduler(*this),
+          imuPipeline(mpu6500),
+          latencyTracer(*this),
+          cycleProfiler(*this),
+          traceBuffer(*this),
+          schedulerCosts(*this),
+          overrunMonitor(*this, OVERRUN_MONITOR_CONFIG),
+#ifdef ENABLE_SAMPLING_PROFILER
+          samplingProfiler(*this),
+#endif
+#if defined(PLATFORM_HOSTED) && !defined(ENV_UNIT_TESTS)
+          virtualRemote(*this),
+          controlOperatorInterface(virtualRemote, imuPipeline),
+#else
+          controlOperatorInterface(remote, imuPipeline),
+#endif
+          remoteFailsafe(*this, controlOperatorInterface, REMOTE_FAILSAFE_CONFIG)
+    {
+    }
+
+    static constexpr control::RemoteFailsafeConfig REMOTE_FAILSAFE_CONFIG{};
+    static constexpr diagnostics::OverrunMonitorConfig OVERRUN_MONITOR_CONFIG{};
 
 public:
+#if defined(PLATFORM_HOSTED) && !defined(ENV_UNIT_TESTS)
+    communication::can::SocketCanBridge socketCanBridge;
+#endif
+    communication::can::CanTxScheduler canTxScheduler;
+    control::imu::ImuPipeline imuPipeline;
+    diagnostics::LatencyTracer latencyTracer;
+    diagnostics::CycleProfiler cycleProfiler;
+    diagnostics::TraceBuffer traceBuffer;
+    diagnostics::SchedulerCosts schedulerCosts;
+    diagnostics::OverrunMonitor overrunMonitor;
+#ifdef ENABLE_SAMPLING_PROFILER
+    diagnostics::SamplingProfiler samplingProfiler;
+#endif
+
+#if defined(PLATFORM_HOSTED) && !defined(ENV_UNIT_TESTS)
+    communication::serial::VirtualRemote virtualRemote;
+#endif
+
 #ifdef ENV_UNIT_TESTS
     control::MockControlOperatorInterface controlOperatorInterface;
 #else
     control::ControlOperatorInterface controlOperatorInterface;
 #endif
+    control::RemoteFailsafe remoteFailsafe;
 };  // class Drivers
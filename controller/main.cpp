@@ -17,62 +17,56 @@
  * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
  */
 
-#include "tap/architecture/clock.hpp"
-#include "tap/architecture/periodic_timer.hpp"
-#include "tap/architecture/profiler.hpp"
+#ifdef PLATFORM_HOSTED
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#endif
+
 #include "tap/board/board.hpp"
 
+#include "architecture/clock.hpp"
+#include "architecture/cycle_counter.hpp"
+#include "architecture/robot_loop.hpp"
 #include "control/robot.hpp"
-#include "modm/architecture/interface/delay.hpp"
 
 #include "drivers_singleton.hpp"
 
-static constexpr float IMU_SMAPLE_FREQUENCY = 500;
-static constexpr float MAHONY_KP = 0.5f;
-static constexpr float MAHONY_KI = 0;
-
-tap::arch::PeriodicMilliTimer sendMotorTimeout(2);
-
 control::Robot robot(*DoNotUse_getDrivers());
 
+architecture::RobotLoop robotLoop(*DoNotUse_getDrivers());
+
 // Place any sort of input/output initialization here. For example, place
 // serial init stuff here.
 static void initializeIo(Drivers *drivers);
 
-// Anything that you would like to be called place here. It will be called
-// very frequently. Use PeriodicMilliTimers if you don't want something to be
-// called as frequently.
-static void updateIo(Drivers *drivers);
+#ifdef PLATFORM_HOSTED
+// Set to a number of control ticks to run them in virtual time as fast as possible, print how long
+// that took on the host and exit, instead of running in real time.
+static constexpr const char *BENCHMARK_TICKS_ENV = "ROBOT_LOOP_BENCHMARK_TICKS";
+
+static int runBenchmark(uint32_t ticks);
+#endif
 
 int main()
 {
-    /*
-     * NOTE: We are using DoNotUse_getDrivers here because in the main
-     *      robot loop we must access the singleton drivers to update
-     *      IO states and run the scheduler.
-     */
     Drivers *drivers = DoNotUse_getDrivers();
 
     Board::initialize();
+    architecture::cycle_counter::initialize();
     initializeIo(drivers);
     robot.initSubsystemCommands();
+    robotLoop.setPhaseReference(&robot.getPhaseReferenceMotor());
 
-    while (1)
+#ifdef PLATFORM_HOSTED
+    if (const char *benchmarkTicks = std::getenv(BENCHMARK_TICKS_ENV))
     {
-        // do this as fast as you can
-        PROFILE(drivers->profiler, updateIo, (drivers));
-
-        if (sendMotorTimeout.execute())
-        {
-            PROFILE(drivers->profiler, drivers->mpu6500.periodicIMUUpdate, ());
-            PROFILE(drivers->profiler, drivers->commandScheduler.run, ());
-            PROFILE(drivers->profiler, drivers->djiMotorTxHandler.encodeAndSendCanData, ());
-            PROFILE(drivers->profiler, drivers->terminalSerial.update, ());
-        }
-
-        modm::delay_us(10);
+        architecture::clock::useVirtualTime();
+        return runBenchmark(std::strtoul(benchmarkTicks, nullptr, 10));
     }
-    return 0;
+#endif
+
+    robotLoop.run();
 }
 
 static void initializeIo(Drivers *drivers)
@@ -82,19 +76,45 @@ static void initializeIo(Drivers *drivers)
     drivers->digital.init();
     drivers->leds.init();
     drivers->can.initialize();
+#if defined(PLATFORM_HOSTED) && !defined(ENV_UNIT_TESTS)
+    drivers->socketCanBridge.initialize();
+#endif
     drivers->errorController.init();
     drivers->remote.initialize();
-    drivers->mpu6500.init(IMU_SMAPLE_FREQUENCY, MAHONY_KP, MAHONY_KI);
+#if defined(PLATFORM_HOSTED) && !defined(ENV_UNIT_TESTS)
+    drivers->virtualRemote.initialize();
+#endif
+    drivers->imuPipeline.initialize();
     drivers->refSerial.initialize();
     drivers->terminalSerial.initialize();
-    drivers->schedulerTerminalHandler.init();
+    // Registers "scheduler", passing everything but costs to the scheduler terminal handler
+    drivers->schedulerCosts.init();
     drivers->djiMotorTerminalSerialHandler.init();
+    drivers->canTxScheduler.init();
+    drivers->latencyTracer.init();
+    drivers->cycleProfiler.init();
+    drivers->traceBuffer.init();
+    drivers->overrunMonitor.init();
+#ifdef ENABLE_SAMPLING_PROFILER
+    drivers->samplingProfiler.init();
+#endif
+    drivers->remoteFailsafe.init();
 }
 
-static void updateIo(Drivers *drivers)
+#ifdef PLATFORM_HOSTED
+static int runBenchmark(uint32_t ticks)
 {
-    drivers->canRxHandler.pollCanData();
-    drivers->refSerial.updateSerial();
-    drivers->remote.read();
-    drivers->mpu6500.read();
+    auto start = std::chrono::steady_clock::now();
+    uint64_t iterations = robotLoop.runTicks(ticks);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::printf(
+        "%u control ticks (%.1f s simulated) in %llu iterations took %.3f s: %.0f ticks/s\n",
+        ticks,
+        ticks * architecture::RobotLoop::CONTROL_PERIOD_US / 1e6,
+        static_cast<unsigned long long>(iterations),
+        elapsed.count(),
+        ticks / elapsed.count());
+    return 0;
 }
+#endif
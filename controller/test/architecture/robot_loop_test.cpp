@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstdlib>
+
+#include <gtest/gtest.h>
+
+#include "architecture/clock.hpp"
+#include "architecture/robot_loop.hpp"
+#include "control/motor/timestamped_dji_motor.hpp"
+
+#include "drivers.hpp"
+
+using namespace architecture;
+using control::motor::TimestampedDjiMotor;
+using testing::NiceMock;
+
+/// Phase of the simulated motor's feedback frames within each feedback period.
+static constexpr uint32_t FEEDBACK_PHASE_US = 500;
+
+/// Makes `motor` report a feedback frame every MOTOR_FEEDBACK_PERIOD_US at FEEDBACK_PHASE_US.
+static void simulateFeedback(NiceMock<TimestampedDjiMotor> &motor)
+{
+    ON_CALL(motor, getLastFeedbackTime).WillByDefault([] {
+        uint32_t now = clock::getTimeMicroseconds();
+        return now - (now - FEEDBACK_PHASE_US) % RobotLoop::MOTOR_FEEDBACK_PERIOD_US;
+    });
+}
+
+/// Microseconds between the reference feedback frame and the last control tick.
+static int32_t feedbackToTickDelay(const RobotLoop &robotLoop)
+{
+    return robotLoop.getControlTickTimer().getPhaseError() +
+           static_cast<int32_t>(RobotLoop::CONTROL_TICK_PHASE_OFFSET_US);
+}
+
+class RobotLoopTest : public testing::Test
+{
+protected:
+    RobotLoopTest()
+        : robotLoop(drivers),
+          motor(&drivers, tap::motor::MOTOR1, tap::can::CanBus::CAN_BUS1, false, "reference")
+    {
+    }
+
+    void SetUp() override
+    {
+        clock::useVirtualTime(1'000'000);
+        simulateFeedback(motor);
+    }
+
+    void TearDown() override { clock::useRealTime(); }
+
+    Drivers drivers;
+    RobotLoop robotLoop;
+    NiceMock<TimestampedDjiMotor> motor;
+};
+
+TEST_F(RobotLoopTest, runTicks_without_phase_reference_ticks_at_fixed_period)
+{
+    robotLoop.runTicks(1);
+    uint32_t nextTickUs = robotLoop.getControlTickTimer().getNextTickTime();
+
+    robotLoop.runTicks(10);
+
+    EXPECT_EQ(11u, robotLoop.getTickCount());
+    EXPECT_EQ(0, robotLoop.getControlTickTimer().getPhaseError());
+    EXPECT_EQ(
+        nextTickUs + 10 * RobotLoop::CONTROL_PERIOD_US,
+        robotLoop.getControlTickTimer().getNextTickTime());
+}
+
+TEST_F(RobotLoopTest, runTicks_phase_locks_tick_to_reference_feedback)
+{
+    if (!RobotLoop::LATENCY_OPTIMIZED_TICK)
+    {
+        GTEST_SKIP() << "the control tick is not phase locked";
+    }
+
+    robotLoop.setPhaseReference(&motor);
+
+    robotLoop.runTicks(1);
+    int32_t initialDelay = feedbackToTickDelay(robotLoop);
+
+    robotLoop.runTicks(50);
+    int32_t lockedDelay = feedbackToTickDelay(robotLoop);
+
+    // The first tick lands wherever the clock is, half a feedback period after the frame
+    EXPECT_EQ(static_cast<int32_t>(FEEDBACK_PHASE_US), initialDelay);
+    EXPECT_LT(lockedDelay, initialDelay);
+    // Errors smaller than one step of the correction shift are not corrected
+    EXPECT_NEAR(
+        RobotLoop::CONTROL_TICK_PHASE_OFFSET_US,
+        lockedDelay,
+        1 << ControlTickTimer::PHASE_CORRECTION_SHIFT);
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "architecture/clock.hpp"
+#include "communication/can/can_tx_scheduler.hpp"
+#include "control/motor/timestamped_dji_motor.hpp"
+
+#include "drivers.hpp"
+
+using communication::can::CanTxScheduler;
+using control::motor::TimestampedDjiMotor;
+using tap::can::CanBus;
+using testing::NiceMock;
+using testing::Return;
+
+class CanTxSchedulerTest : public testing::Test
+{
+protected:
+    CanTxSchedulerTest()
+        : scheduler(drivers),
+          chassisMotors{{
+              {&drivers, tap::motor::MOTOR1, CanBus::CAN_BUS1, false, "RF"},
+              {&drivers, tap::motor::MOTOR2, CanBus::CAN_BUS1, false, "LF"},
+              {&drivers, tap::motor::MOTOR3, CanBus::CAN_BUS1, false, "LB"},
+              {&drivers, tap::motor::MOTOR4, CanBus::CAN_BUS1, false, "RB"},
+          }},
+          yawMotor(&drivers, tap::motor::MOTOR6, CanBus::CAN_BUS1, false, "yaw")
+    {
+    }
+
+    void SetUp() override
+    {
+        architecture::clock::useVirtualTime(1'000'000);
+
+        ON_CALL(drivers.can, sendMessage).WillByDefault([this](CanBus bus, const modm::can::Message &message) {
+            sent.push_back({bus, message});
+            return true;
+        });
+
+        for (uint8_t ii = 0; ii < chassisMotors.size(); ii++)
+        {
+            attach(chassisMotors[ii], tap::motor::MOTOR1 + ii, 100 * (ii + 1));
+        }
+        attach(yawMotor, tap::motor::MOTOR6, -300);
+    }
+
+    void TearDown() override { architecture::clock::useRealTime(); }
+
+    /// Adds `motor` on CAN_BUS1 as motor `id`, asking for `output`.
+    void attach(NiceMock<TimestampedDjiMotor> &motor, uint32_t id, int16_t output)
+    {
+        ON_CALL(motor, getMotorIdentifier).WillByDefault(Return(id));
+        ON_CALL(motor, getCanBus).WillByDefault(Return(CanBus::CAN_BUS1));
+        ON_CALL(motor, getOutputDesired).WillByDefault(Return(output));
+        scheduler.addMotor(&motor);
+    }
+
+    /// The big endian output in `slot` of `message`.
+    static int16_t outputInSlot(const modm::can::Message &message, uint8_t slot)
+    {
+        return static_cast<int16_t>(message.data[2 * slot] << 8 | message.data[2 * slot + 1]);
+    }
+
+    struct SentFrame
+    {
+        CanBus bus;
+        modm::can::Message message;
+    };
+
+    Drivers drivers;
+    CanTxScheduler scheduler;
+    std::array<NiceMock<TimestampedDjiMotor>, 4> chassisMotors;
+    NiceMock<TimestampedDjiMotor> yawMotor;
+    std::vector<SentFrame> sent;
+};
+
+TEST_F(CanTxSchedulerTest, sendFrames_packs_motors_into_one_frame_per_identifier)
+{
+    EXPECT_TRUE(scheduler.sendFrames());
+
+    ASSERT_EQ(2u, sent.size());
+    for (const SentFrame &frame : sent)
+    {
+        EXPECT_EQ(CanBus::CAN_BUS1, frame.bus);
+    }
+
+    EXPECT_EQ(0x200u, sent[0].message.getIdentifier());
+    for (uint8_t slot = 0; slot < CanTxScheduler::MOTORS_PER_FRAME; slot++)
+    {
+        EXPECT_EQ(100 * (slot + 1), outputInSlot(sent[0].message, slot));
+    }
+
+    EXPECT_EQ(0x1FFu, sent[1].message.getIdentifier());
+    EXPECT_EQ(0, outputInSlot(sent[1].message, 0));
+    EXPECT_EQ(-300, outputInSlot(sent[1].message, 1));
+}
+
+TEST_F(CanTxSchedulerTest, sendFrames_holds_unchanged_frames_until_keepalive)
+{
+    scheduler.sendFrames();
+    sent.clear();
+
+    architecture::clock::advance(2'000);
+    EXPECT_FALSE(scheduler.sendFrames());
+    EXPECT_TRUE(sent.empty());
+
+    // Only the frame whose payload changed goes out
+    ON_CALL(yawMotor, getOutputDesired).WillByDefault(Return(-200));
+    architecture::clock::advance(2'000);
+    EXPECT_TRUE(scheduler.sendFrames());
+    ASSERT_EQ(1u, sent.size());
+    EXPECT_EQ(0x1FFu, sent[0].message.getIdentifier());
+    sent.clear();
+
+    architecture::clock::advance(CanTxScheduler::KEEPALIVE_PERIOD_US);
+    EXPECT_TRUE(scheduler.sendFrames());
+    EXPECT_EQ(2u, sent.size());
+}
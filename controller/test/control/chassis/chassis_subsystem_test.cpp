@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "control/chassis/chassis_kinematics.hpp"
+#include "control/chassis/chassis_subsystem.hpp"
+
+#include "drivers.hpp"
+
+using namespace control::chassis;
+using testing::Return;
+
+static constexpr float WHEEL_BASE_M = 0.4f;
+static constexpr float TRACK_WIDTH_M = 0.4f;
+/// Feedback age reported by a motor that has gone silent, well past the timeout.
+static constexpr uint32_t SILENT_FEEDBACK_AGE_US = 1'000'000;
+
+/// Exposes the motors so their feedback can be faked.
+class TestChassisSubsystem : public ChassisSubsystem
+{
+public:
+    using ChassisSubsystem::ChassisSubsystem;
+    using ChassisSubsystem::motors;
+};
+
+class ChassisSubsystemTest : public testing::Test
+{
+protected:
+    ChassisSubsystemTest()
+        : chassis(
+              drivers,
+              ChassisConfig{
+                  .leftFrontId = tap::motor::MOTOR2,
+                  .leftBackId = tap::motor::MOTOR3,
+                  .rightBackId = tap::motor::MOTOR4,
+                  .rightFrontId = tap::motor::MOTOR1,
+                  .canBus = tap::can::CanBus::CAN_BUS1,
+                  .wheelVelocityPidConfig = modm::Pid<float>::Parameter(10, 0, 0, 0, 16'000),
+                  .motorTimeoutUs = 10'000,
+                  .wheelBaseM = WHEEL_BASE_M,
+                  .trackWidthM = TRACK_WIDTH_M,
+                  .wheelVelocityFeedforward = 0,
+                  .setpointSlewRpmPerSec = 0,
+              }),
+          kinematics(makeMecanumGeometry(
+              WHEEL_BASE_M,
+              TRACK_WIDTH_M,
+              WHEEL_DIAMETER_M / 2,
+              GEAR_RATIO))
+    {
+    }
+
+    void SetUp() override
+    {
+        for (auto &motor : chassis.motors)
+        {
+            ON_CALL(motor, getFeedbackAge).WillByDefault(Return(0));
+        }
+    }
+
+    void silence(ChassisSubsystem::MotorId motorId)
+    {
+        ON_CALL(chassis.motors[static_cast<uint8_t>(motorId)], getFeedbackAge)
+            .WillByDefault(Return(SILENT_FEEDBACK_AGE_US));
+    }
+
+    /// The twist the online wheels' setpoints drive, ignoring `excluded`.
+    Twist setpointTwistExcluding(ChassisSubsystem::MotorId excluded)
+    {
+        ChassisSubsystem::Kinematics::WheelSpeeds speeds;
+        for (uint8_t ii = 0; ii < speeds.size(); ii++)
+        {
+            speeds[ii] = chassis.getSetpointRpm(static_cast<ChassisSubsystem::MotorId>(ii)) /
+                         kinematics.getShaftRpmPerWheelRadPerSec();
+        }
+        return kinematics.toTwistExcluding(speeds, static_cast<uint8_t>(excluded));
+    }
+
+    float maxAbsSetpointRpm()
+    {
+        float peak = 0;
+        for (uint8_t ii = 0; ii < static_cast<uint8_t>(ChassisSubsystem::MotorId::NUM_MOTORS);
+             ii++)
+        {
+            peak = std::max(
+                peak,
+                std::fabs(chassis.getSetpointRpm(static_cast<ChassisSubsystem::MotorId>(ii))));
+        }
+        return peak;
+    }
+
+    Drivers drivers;
+    TestChassisSubsystem chassis;
+    const ChassisSubsystem::Kinematics kinematics;
+};
+
+TEST_F(ChassisSubsystemTest, refresh_silent_motor_degrades_to_three_wheels_that_keep_the_twist)
+{
+    const Twist twist{0.5f, -0.3f, 1.0f};
+    chassis.setDesiredTwist(twist);
+    chassis.refresh();
+    ASSERT_FALSE(chassis.isDegraded());
+
+    silence(ChassisSubsystem::MotorId::RF);
+    chassis.refresh();
+
+    EXPECT_TRUE(chassis.isDegraded());
+    EXPECT_FALSE(chassis.isMotorOnline(ChassisSubsystem::MotorId::RF));
+    EXPECT_FLOAT_EQ(0, chassis.getSetpointRpm(ChassisSubsystem::MotorId::RF));
+
+    Twist driven = setpointTwistExcluding(ChassisSubsystem::MotorId::RF);
+    EXPECT_NEAR(twist.x, driven.x, 1e-3f);
+    EXPECT_NEAR(twist.y, driven.y, 1e-3f);
+    EXPECT_NEAR(twist.z, driven.z, 1e-3f);
+}
+
+TEST_F(ChassisSubsystemTest, refresh_degraded_saturates_over_online_wheels_only)
+{
+    // Far beyond the envelope, and the left back wheel needs the most speed for it
+    const Twist twist{10, 10, -2};
+    chassis.setDesiredTwist(twist);
+    silence(ChassisSubsystem::MotorId::LB);
+    chassis.refresh();
+    ASSERT_TRUE(chassis.isDegraded());
+
+    EXPECT_NEAR(MAX_WHEELSPEED_RPM, maxAbsSetpointRpm(), 1);
+
+    // Scaled down along the commanded twist, as far as the online wheels allow
+    Twist driven = setpointTwistExcluding(ChassisSubsystem::MotorId::LB);
+    float scale = driven.x / twist.x;
+    EXPECT_NEAR(twist.y * scale, driven.y, 1e-3f);
+    EXPECT_NEAR(twist.z * scale, driven.z, 1e-3f);
+
+    // Faster than the four wheel limit, which the offline wheel would have set
+    TwistToRpmTransform fourWheels(
+        kinematics,
+        kinematics.getShaftRpmPerWheelRadPerSec(),
+        MAX_WHEELSPEED_RPM);
+    EXPECT_GT(scale, fourWheels.getMaxScaleAlong(twist) * 1.05f);
+}
+
+TEST_F(ChassisSubsystemTest, refresh_two_silent_motors_stops_the_chassis)
+{
+    chassis.setDesiredTwist(Twist{0.5f, 0, 0});
+    silence(ChassisSubsystem::MotorId::LF);
+    silence(ChassisSubsystem::MotorId::RB);
+    chassis.refresh();
+
+    EXPECT_FALSE(chassis.isDegraded());
+    EXPECT_FLOAT_EQ(0, maxAbsSetpointRpm());
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "control/chassis/chassis_constants.hpp"
+#include "control/chassis/traction_controller.hpp"
+
+using namespace control::chassis;
+
+static constexpr uint32_t DT_US = 2'000;
+static constexpr float DT = DT_US * 1e-6f;
+
+class TractionControllerTest : public testing::Test
+{
+protected:
+    TractionControllerTest()
+        : kinematics(makeMecanumGeometry(0.4f, 0.4f, WHEEL_DIAMETER_M / 2, GEAR_RATIO)),
+          traction(config, kinematics)
+    {
+    }
+
+    /// Drives forward from rest for `ticks` ticks, the wheels accelerating at `wheelAccel` and the
+    /// IMU measuring `imuAccel`, both in m/s^2.
+    void driveForward(float wheelAccel, float imuAccel, int ticks)
+    {
+        traction.update(kinematics.toWheelSpeeds(Twist{}), ImuMotion{}, 0, true);
+        for (int tick = 1; tick <= ticks; tick++)
+        {
+            Twist wheelTwist{wheelAccel * DT * tick, 0, 0};
+            traction.update(
+                kinematics.toWheelSpeeds(wheelTwist),
+                ImuMotion{.accelX = imuAccel, .accelY = 0, .yawRate = 0},
+                DT_US,
+                true);
+        }
+    }
+
+    const TractionControlConfig config{};
+    const TractionController::Kinematics kinematics;
+    TractionController traction;
+};
+
+TEST_F(TractionControllerTest, update_all_wheels_spinning_up_cuts_every_wheel)
+{
+    // Wheels accelerate at 15 m/s^2 for 200 ms while the chassis only manages 3 m/s^2
+    driveForward(15, 3, 100);
+
+    EXPECT_NEAR(0.6f, traction.getReference().x, 0.05f);
+    for (uint8_t wheel = 0; wheel < TractionController::NUM_WHEELS; wheel++)
+    {
+        EXPECT_GT(traction.getSlip(wheel), config.slipThreshold);
+        EXPECT_LT(traction.getTorqueScale(wheel), 0.5f);
+    }
+}
+
+TEST_F(TractionControllerTest, update_wheels_following_the_imu_keep_full_torque)
+{
+    driveForward(3, 3, 100);
+
+    EXPECT_NEAR(0.6f, traction.getReference().x, 0.05f);
+    for (uint8_t wheel = 0; wheel < TractionController::NUM_WHEELS; wheel++)
+    {
+        EXPECT_LT(traction.getSlip(wheel), config.slipThreshold);
+        EXPECT_FLOAT_EQ(1, traction.getTorqueScale(wheel));
+    }
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if defined(PLATFORM_HOSTED) && !defined(ENV_UNIT_TESTS)
+
+#include "virtual_remote.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "tap/architecture/clock.hpp"
+#include "tap/errors/create_errors.hpp"
+
+#include "drivers.hpp"
+
+namespace communication::serial
+{
+VirtualRemote::VirtualRemote(Drivers &drivers) : drivers(drivers) {}
+
+VirtualRemote::~VirtualRemote()
+{
+    if (socketFd >= 0)
+    {
+        close(socketFd);
+    }
+}
+
+void VirtualRemote::initialize()
+{
+    const char *portOverride = std::getenv("REMOTE_UDP_PORT");
+    uint16_t port = portOverride != nullptr ? std::atoi(portOverride) : DEFAULT_PORT;
+
+    int fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+    if (fd < 0)
+    {
+        RAISE_ERROR((&drivers), "virtual remote: could not create socket");
+        return;
+    }
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0)
+    {
+        RAISE_ERROR((&drivers), "virtual remote: could not bind port");
+        close(fd);
+        return;
+    }
+
+    socketFd = fd;
+}
+
+void VirtualRemote::read()
+{
+    uint32_t now = tap::arch::clock::getTimeMicroseconds();
+
+    uint8_t frame[FRAME_LENGTH + 1];
+    while (socketFd >= 0)
+    {
+        ssize_t length = recv(socketFd, frame, sizeof(frame), 0);
+        if (length < 0)
+        {
+            break;
+        }
+
+        // Anything but a whole frame is line noise, as it would be on the UART
+        if (length != FRAME_LENGTH)
+        {
+            continue;
+        }
+
+        parseFrame(frame);
+        connected = true;
+        lastFrameUs = now;
+        updateCounter++;
+    }
+
+    if (connected && now - lastFrameUs > DISCONNECT_TIMEOUT_US)
+    {
+        reset();
+    }
+}
+
+float VirtualRemote::getChannel(Remote::Channel channel) const
+{
+    return state.channels[static_cast<uint8_t>(channel)] / static_cast<float>(STICK_MAX_VALUE);
+}
+
+VirtualRemote::Remote::SwitchState VirtualRemote::getSwitch(Remote::Switch sw) const
+{
+    return sw == Remote::Switch::LEFT_SWITCH ? state.leftSwitch : state.rightSwitch;
+}
+
+void VirtualRemote::parseFrame(const uint8_t *frame)
+{
+    auto channel = [](uint16_t raw) -> int16_t {
+        int16_t value = static_cast<int16_t>((raw & 0x07FF) - CHANNEL_CENTER);
+        return std::clamp<int16_t>(value, -STICK_MAX_VALUE, STICK_MAX_VALUE);
+    };
+
+    state.channels[static_cast<uint8_t>(Remote::Channel::RIGHT_HORIZONTAL)] =
+        channel(frame[0] | frame[1] << 8);
+    state.channels[static_cast<uint8_t>(Remote::Channel::RIGHT_VERTICAL)] =
+        channel(frame[1] >> 3 | frame[2] << 5);
+    state.channels[static_cast<uint8_t>(Remote::Channel::LEFT_HORIZONTAL)] =
+        channel(frame[2] >> 6 | frame[3] << 2 | frame[4] << 10);
+    state.channels[static_cast<uint8_t>(Remote::Channel::LEFT_VERTICAL)] =
+        channel(frame[4] >> 1 | frame[5] << 7);
+    state.channels[static_cast<uint8_t>(Remote::Channel::WHEEL)] =
+        channel(frame[16] | frame[17] << 8);
+
+    state.leftSwitch = static_cast<Remote::SwitchState>((frame[5] >> 6) & 0x03);
+    state.rightSwitch = static_cast<Remote::SwitchState>((frame[5] >> 4) & 0x03);
+
+    state.mouseX = static_cast<int16_t>(frame[6] | frame[7] << 8);
+    state.mouseY = static_cast<int16_t>(frame[8] | frame[9] << 8);
+    state.mouseZ = static_cast<int16_t>(frame[10] | frame[11] << 8);
+    state.mouseL = frame[12] != 0;
+    state.mouseR = frame[13] != 0;
+
+    state.keys = frame[14] | frame[15] << 8;
+
+    drivers.commandMapper.handleKeyStateChange(
+        state.keys,
+        state.leftSwitch,
+        state.rightSwitch,
+        state.mouseL,
+        state.mouseR);
+}
+
+void VirtualRemote::reset()
+{
+    state = State{};
+    connected = false;
+
+    drivers.commandMapper.handleKeyStateChange(
+        state.keys,
+        state.leftSwitch,
+        state.rightSwitch,
+        state.mouseL,
+        state.mouseR);
+}
+}  // namespace communication::serial
+
+#endif
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "chassis_kinematics.hpp"
+
+namespace control::chassis
+{
+/// Geometry of the standard robot's mecanum chassis. Changing chassis means changing this.
+static constexpr ChassisGeometry<4> STANDARD_CHASSIS_GEOMETRY = makeMecanumGeometry(
+    /* wheelBase   */ 0.4f,
+    /* trackWidth  */ 0.4f,
+    /* wheelRadius */ 0.038f,
+    /* gearRatio   */ 19.0f);
+
+/// A chassis with the standard robot's layout whose inverse kinematics maps a twist of unit stick
+/// deflections to wheel speeds with unit coefficients, the classic (vy +- vx +- w) mixing.
+static constexpr ChassisGeometry<4> NORMALIZED_CHASSIS_GEOMETRY = makeMecanumGeometry(
+    /* wheelBase   */ 1.0f,
+    /* trackWidth  */ 1.0f,
+    /* wheelRadius */ 1.0f,
+    /* gearRatio   */ 1.0f);
+}  // namespace control::chassis
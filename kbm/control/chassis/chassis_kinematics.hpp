@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace control::chassis
+{
+/// Body velocity. x is forward and y is left, both in m/s; z is counter-clockwise, in rad/s.
+struct Twist
+{
+    float x;
+    float y;
+    float z;
+};
+
+/// Placement of a single wheel, in a body frame with x forward, y left and the origin at the
+/// chassis' center of rotation.
+struct WheelGeometry
+{
+    float x;            ///< Position along x, in m.
+    float y;            ///< Position along y, in m.
+    float driveAngle;   ///< Angle of the direction the wheel rolls when turned forward, in rad.
+    float rollerAngle;  ///< Angle of the rollers' axes relative to the drive direction, in rad.
+                        ///< 0 for omni wheels, +-pi/4 for mecanum wheels.
+};
+
+template <std::size_t N>
+struct ChassisGeometry
+{
+    std::array<WheelGeometry, N> wheels;
+    float wheelRadius;  ///< in m.
+    float gearRatio;    ///< Motor shaft turns per wheel turn.
+};
+
+namespace detail
+{
+static constexpr float PI = 3.14159265358979f;
+
+/// Taylor series sine, usable in constant expressions.
+constexpr float sin(float angle)
+{
+    while (angle > PI) angle -= 2 * PI;
+    while (angle < -PI) angle += 2 * PI;
+
+    float term = angle;
+    float sum = angle;
+    for (int i = 1; i < 10; i++)
+    {
+        term *= -angle * angle / ((2 * i) * (2 * i + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr float cos(float angle) { return sin(angle + PI / 2); }
+}  // namespace detail
+
+/**
+ * @brief Inverse and forward kinematics of a chassis with N omni or mecanum wheels.
+ *
+ * A wheel's rollers can only transmit force along their own axis, so a wheel turning at angular
+ * velocity w moves its contact patch along the roller axis a at r * w * cos(roller angle). Equating
+ * that with the component along a of the chassis velocity at the wheel gives one row of the
+ * inverse kinematics. The forward kinematics is the least squares pseudo-inverse of those rows,
+ * and one forward kinematics per wheel is also kept that ignores that wheel, for cross checking a
+ * wheel against the others.
+ *
+ * Everything is computed in the constructor, which is constexpr, so for a constexpr geometry all
+ * matrices are built at compile time and applying them costs one small matrix-vector multiply.
+ */
+template <std::size_t N>
+class ChassisKinematics
+{
+public:
+    static_assert(N >= 3, "the body twist has three degrees of freedom");
+
+    static constexpr std::size_t NUM_WHEELS = N;
+
+    using WheelSpeeds = std::array<float, N>;
+    /// N x 3, maps a Twist to wheel angular velocities in rad/s.
+    using InverseMatrix = std::array<std::array<float, 3>, N>;
+    /// 3 x N, maps wheel angular velocities in rad/s to a Twist.
+    using ForwardMatrix = std::array<std::array<float, N>, 3>;
+
+    constexpr explicit ChassisKinematics(const ChassisGeometry<N> &geometry)
+        : inverseMatrix(),
+          forwardMatrix(),
+          forwardExcludingMatrices(),
+          shaftRpmPerWheelRadPerSec(geometry.gearRatio * 60.0f / (2 * detail::PI))
+    {
+        for (std::size_t i = 0; i < N; i++)
+        {
+            const WheelGeometry &wheel = geometry.wheels[i];
+            float rollerAxis = wheel.driveAngle + wheel.rollerAngle;
+            float ax = detail::cos(rollerAxis);
+            float ay = detail::sin(rollerAxis);
+            float scale = 1.0f / (geometry.wheelRadius * detail::cos(wheel.rollerAngle));
+
+            inverseMatrix[i] = {ax * scale, ay * scale, (ay * wheel.x - ax * wheel.y) * scale};
+        }
+
+        forwardMatrix = pseudoInverse(N);
+        for (std::size_t excluded = 0; excluded < N; excluded++)
+        {
+            forwardExcludingMatrices[excluded] = pseudoInverse(excluded);
+        }
+    }
+
+    constexpr const InverseMatrix &getInverseMatrix() const { return inverseMatrix; }
+
+    constexpr const ForwardMatrix &getForwardMatrix() const { return forwardMatrix; }
+
+    /**
+     * @return wheel angular velocities, in rad/s, that produce `twist`.
+     */
+    constexpr WheelSpeeds toWheelSpeeds(const Twist &twist) const
+    {
+        WheelSpeeds speeds{};
+        for (std::size_t i = 0; i < N; i++)
+        {
+            speeds[i] = inverseMatrix[i][0] * twist.x + inverseMatrix[i][1] * twist.y +
+                        inverseMatrix[i][2] * twist.z;
+        }
+        return speeds;
+    }
+
+    /**
+     * @return the twist that best explains `speeds`, wheel angular velocities in rad/s.
+     */
+    constexpr Twist toTwist(const WheelSpeeds &speeds) const
+    {
+        return multiply(forwardMatrix, speeds);
+    }
+
+    /**
+     * @return the twist that best explains `speeds` when the speed of wheel `excluded` is ignored.
+     */
+    constexpr Twist toTwistExcluding(const WheelSpeeds &speeds, std::size_t excluded) const
+    {
+        return multiply(forwardExcludingMatrices[excluded], speeds);
+    }
+
+    /**
+     * @return the motor shaft RPM corresponding to one rad/s of wheel angular velocity.
+     */
+    constexpr float getShaftRpmPerWheelRadPerSec() const { return shaftRpmPerWheelRadPerSec; }
+
+private:
+    InverseMatrix inverseMatrix;
+    ForwardMatrix forwardMatrix;
+    std::array<ForwardMatrix, N> forwardExcludingMatrices;
+    float shaftRpmPerWheelRadPerSec;
+
+    static constexpr Twist multiply(const ForwardMatrix &matrix, const WheelSpeeds &speeds)
+    {
+        float twist[3] = {};
+        for (std::size_t row = 0; row < 3; row++)
+        {
+            for (std::size_t i = 0; i < N; i++)
+            {
+                twist[row] += matrix[row][i] * speeds[i];
+            }
+        }
+        return Twist{twist[0], twist[1], twist[2]};
+    }
+
+    /// (A^T A)^-1 A^T over the rows of the inverse kinematics, leaving out row `excluded` (N to
+    /// use every row). Columns of left out rows are zero.
+    constexpr ForwardMatrix pseudoInverse(std::size_t excluded) const
+    {
+        float ata[3][3] = {};
+        for (std::size_t i = 0; i < N; i++)
+        {
+            if (i == excluded) continue;
+            for (std::size_t r = 0; r < 3; r++)
+            {
+                for (std::size_t c = 0; c < 3; c++)
+                {
+                    ata[r][c] += inverseMatrix[i][r] * inverseMatrix[i][c];
+                }
+            }
+        }
+
+        // Adjugate over determinant
+        float cof[3][3] = {
+            {ata[1][1] * ata[2][2] - ata[1][2] * ata[2][1],
+             ata[1][2] * ata[2][0] - ata[1][0] * ata[2][2],
+             ata[1][0] * ata[2][1] - ata[1][1] * ata[2][0]},
+            {ata[0][2] * ata[2][1] - ata[0][1] * ata[2][2],
+             ata[0][0] * ata[2][2] - ata[0][2] * ata[2][0],
+             ata[0][1] * ata[2][0] - ata[0][0] * ata[2][1]},
+            {ata[0][1] * ata[1][2] - ata[0][2] * ata[1][1],
+             ata[0][2] * ata[1][0] - ata[0][0] * ata[1][2],
+             ata[0][0] * ata[1][1] - ata[0][1] * ata[1][0]},
+        };
+        float det = ata[0][0] * cof[0][0] + ata[0][1] * cof[0][1] + ata[0][2] * cof[0][2];
+
+        ForwardMatrix result{};
+        if (det == 0.0f)
+        {
+            return result;
+        }
+
+        for (std::size_t r = 0; r < 3; r++)
+        {
+            for (std::size_t i = 0; i < N; i++)
+            {
+                if (i == excluded) continue;
+                for (std::size_t c = 0; c < 3; c++)
+                {
+                    // The inverse of a symmetric matrix is the transposed cofactor matrix, which
+                    // is the cofactor matrix itself
+                    result[r][i] += cof[r][c] / det * inverseMatrix[i][c];
+                }
+            }
+        }
+        return result;
+    }
+};
+
+/**
+ * @return geometry of a four wheel mecanum chassis with rollers in an X pattern seen from above.
+ * Wheels are ordered left front, left back, right front, right back.
+ *
+ * @param[in] wheelBase distance between front and back axles, in m.
+ * @param[in] trackWidth distance between left and right wheels, in m.
+ */
+constexpr ChassisGeometry<4> makeMecanumGeometry(
+    float wheelBase,
+    float trackWidth,
+    float wheelRadius,
+    float gearRatio)
+{
+    float x = wheelBase / 2;
+    float y = trackWidth / 2;
+    float roller = detail::PI / 4;
+    return ChassisGeometry<4>{
+        .wheels =
+            {{
+                {x, y, 0, -roller},
+                {-x, y, 0, roller},
+                {x, -y, 0, roller},
+                {-x, -y, 0, -roller},
+            }},
+        .wheelRadius = wheelRadius,
+        .gearRatio = gearRatio,
+    };
+}
+
+/**
+ * @return geometry of a four omni wheel X-drive, wheels at the corners of a square and driving
+ * tangentially. Wheels are ordered left front, left back, right front, right back.
+ *
+ * @param[in] centerToWheel distance from the chassis center to each wheel, in m.
+ */
+constexpr ChassisGeometry<4> makeXDriveGeometry(
+    float centerToWheel,
+    float wheelRadius,
+    float gearRatio)
+{
+    float d = centerToWheel * detail::cos(detail::PI / 4);
+    float pi = detail::PI;
+    return ChassisGeometry<4>{
+        .wheels =
+            {{
+                {d, d, -pi / 4, 0},
+                {-d, d, pi / 4, 0},
+                {d, -d, pi / 4, 0},
+                {-d, -d, -pi / 4, 0},
+            }},
+        .wheelRadius = wheelRadius,
+        .gearRatio = gearRatio,
+    };
+}
+}  // namespace control::chassis
@@ -27,131 +27,31 @@ using tap::communication::serial::Remote;
 
 namespace control
 {
-ControlOperatorInterface::ControlOperatorInterface(Remote &remote) : remote(remote) {}
+ControlOperatorInterface::ControlOperatorInterface(RemoteInput &remote) : remote(remote) {}
+
+float ControlOperatorInterface::mixWheelInput(uint8_t wheel)
+{
+    auto keyAxis = [this](Remote::Key positive, Remote::Key negative) {
+        float axis = (remote.keyPressed(positive) ? KEY_INPUT_SPEED : 0.0f) -
+                     (remote.keyPressed(negative) ? KEY_INPUT_SPEED : 0.0f);
+        return limitVal(axis, -1.0f, 1.0f);
+    };
+
+    chassis::Twist twist{
+        keyAxis(Remote::Key::W, Remote::Key::S),
+        keyAxis(Remote::Key::A, Remote::Key::D),
+        keyAxis(Remote::Key::Q, Remote::Key::E)};
+    return KEY_MIXING.toWheelSpeeds(twist)[wheel];
+}
 
 // STEP 2 (Tank Drive): Add getChassisTankLeftInput and getChassisTankRightInput function
 // definitions
-float ControlOperatorInterface::getChassisOmniLeftFrontInput() {
-    //float result = vertical + horizonttal + right horizontal
-    if (remote.keyPressed(Remote::Key::D) && remote.keyPressed(Remote::Key::Q)){
-        float trans = limitVal(0.1f, -1.0f, 1.0f);
-        float rotate = limitVal(-0.1f, -1.0f, 1.0f);
-        return trans + rotate; 
-    }
-    else-if (remote.keyPressed(Remote::Key::Q)){
-        return limitVal(-0.1f, -1.0f, 1.0f);
-    }
-    else if  (remote.keyPressed(Remote::Key::W)){
-        return limitVal(0.1f, -1.0f, 1.0f);
-    }
-    else if (remote.keyPressed(Remote::Key::A)){
-        return limitVal(-0.1f, -1.0f, 1.0f);
-    } 
-    else if (remote.keyPressed(Remote::Key::S)){
-        return limitVal(-0.1f, -1.0f, 1.0f);
-    }
-    else if (remote.keyPressed(Remote::Key::D)){
-        return limitVal(0.1f, -1.0f, 1.0f);
-    }
-    else if (remote.keyPressed(Remote::Key::E)){
-        return limitVal(0.1f, -1.0f, 1.0f);
-    }
-    else if (remote.keyPressed(Remote::Key::Q)){
-        return limitVal(-0.1f, -1.0f, 1.0f);
-    }
-    else{
-        return 0.0f;
-    }
-}
+float ControlOperatorInterface::getChassisOmniLeftFrontInput() { return mixWheelInput(0); }
 
-float ControlOperatorInterface::getChassisOmniLeftBackInput() {
-    //float result = vertical - horizontal + rightHorizontal;
-    if (remote.keyPressed(Remote::Key::D) && remote.keyPressed(Remote::Key::Q)){
-        float trans = limitVal(-0.1f, -1.0f, 1.0f);
-        float rotate = limitVal(-0.1f, -1.0f, 1.0f);
-        return trans + rotate; 
-    }
-    else if  (remote.keyPressed(Remote::Key::W)){
-        return limitVal(0.1f, -1.0f, 1.0f);
-    }
-    else if (remote.keyPressed(Remote::Key::A)){
-        return limitVal(0.1f, -1.0f, 1.0f);
-    } 
-    else if (remote.keyPressed(Remote::Key::S)){
-        return limitVal(-0.1f, -1.0f, 1.0f);
-    }
-    else if (remote.keyPressed(Remote::Key::D)){
-        return limitVal(-0.1f, -1.0f, 1.0f);
-    }
-    else if (remote.keyPressed(Remote::Key::E)){
-        return limitVal(0.1f, -1.0f, 1.0f);
-    }
-    else if (remote.keyPressed(Remote::Key::Q)){
-        return limitVal(-0.1f, -1.0f, 1.0f);
-    }
-    else{
-        return 0.0f;
-    }
-}
+float ControlOperatorInterface::getChassisOmniLeftBackInput() { return mixWheelInput(1); }
 
-float ControlOperatorInterface::getChassisOmniRightFrontInput() {
-    //float result = vertical - horizontal - rightHorizontal;
-    if (remote.keyPressed(Remote::Key::D) && remote.keyPressed(Remote::Key::Q)){
-        float trans = limitVal(-0.1f, -1.0f, 1.0f);
-        float rotate = limitVal(0.1f, -1.0f, 1.0f);
-        return trans + rotate; 
-    }
-    else if  (remote.keyPressed(Remote::Key::W)){
-        return limitVal(0.1f, -1.0f, 1.0f);
-    }
-    else if (remote.keyPressed(Remote::Key::A)){
-        return limitVal(0.1f, -1.0f, 1.0f);
-    } 
-    else if (remote.keyPressed(Remote::Key::S)){
-        return limitVal(-0.1f, -1.0f, 1.0f);
-    }
-    else if (remote.keyPressed(Remote::Key::D)){
-        return limitVal(-0.1f, -1.0f, 1.0f);
-    }
-    else if (remote.keyPressed(Remote::Key::E)){
-        return limitVal(-0.1f, -1.0f, 1.0f);
-    }
-    else if (remote.keyPressed(Remote::Key::Q)){
-        return limitVal(0.1f, -1.0f, 1.0f);
-    }
-    else{
-        return 0.0f;
-    }
-}
+float ControlOperatorInterface::getChassisOmniRightFrontInput() { return mixWheelInput(2); }
 
-float ControlOperatorInterface::getChassisOmniRightBackInput() {
-    //float result = vertical + horizontal - rightHorizontal;
-    if (remote.keyPressed(Remote::Key::D) && remote.keyPressed(Remote::Key::Q)){
-        float trans = limitVal(0.1f, -1.0f, 1.0f);
-        float rotate = limitVal(0.1f, -1.0f, 1.0f);
-        return trans + rotate; 
-    }
-    else if  (remote.keyPressed(Remote::Key::W)){
-        return limitVal(0.1f, -1.0f, 1.0f);
-    }
-    else if (remote.keyPressed(Remote::Key::A)){
-        return limitVal(-0.1f, -1.0f, 1.0f);
-    } 
-    else if (remote.keyPressed(Remote::Key::S)){
-        return limitVal(-0.1f, -1.0f, 1.0f);
-    }
-    else if (remote.keyPressed(Remote::Key::D)){
-        return limitVal(0.1f, -1.0f, 1.0f);
-    }
-    else if (remote.keyPressed(Remote::Key::E)){
-        return limitVal(-0.1f, -1.0f, 1.0f);
-    }
-    else if (remote.keyPressed(Remote::Key::Q)){
-        return limitVal(0.1f, -1.0f, 1.0f);
-    }
-    else{
-        return 0.0f;
-    }
-}
+float ControlOperatorInterface::getChassisOmniRightBackInput() { return mixWheelInput(3); }
 
-}  // namespace control 
+}  // namespace control
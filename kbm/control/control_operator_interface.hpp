@@ -19,8 +19,17 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include "tap/util_macros.hpp"
 
+#include "control/chassis/chassis_geometry.hpp"
+#include "control/chassis/chassis_kinematics.hpp"
+
+#if defined(PLATFORM_HOSTED) && !defined(ENV_UNIT_TESTS)
+#include "communication/serial/virtual_remote.hpp"
+#endif
+
 namespace tap::communication::serial
 {
 class Remote;
@@ -31,13 +40,34 @@ namespace control
 class ControlOperatorInterface
 {
 public:
-    ControlOperatorInterface(tap::communication::serial::Remote &remote);
+#if defined(PLATFORM_HOSTED) && !defined(ENV_UNIT_TESTS)
+    /// Hosted runs have no receiver and read frames sent by testing/remote_bridge.py instead.
+    using RemoteInput = communication::serial::VirtualRemote;
+#else
+    using RemoteInput = tap::communication::serial::Remote;
+#endif
+
+    ControlOperatorInterface(RemoteInput &remote);
 
     float getChassisOmniLeftFrontInput();
     float getChassisOmniLeftBackInput();
     float getChassisOmniRightFrontInput();
     float getChassisOmniRightBackInput();
 private:
-    tap::communication::serial::Remote &remote;
+    /// Normalized chassis speed commanded by each held key.
+    static constexpr float KEY_INPUT_SPEED = 0.1f;
+
+    /// Mixes normalized key input into normalized wheel speeds.
+    static constexpr chassis::ChassisKinematics<4> KEY_MIXING{
+        chassis::NORMALIZED_CHASSIS_GEOMETRY};
+
+    RemoteInput &remote;
+
+    /**
+     * @return the normalized speed of `wheel`, indexed like the chassis geometry, for the keys
+     * currently held. W/S drive forward and back, A/D strafe left and right and Q/E rotate
+     * counter-clockwise and clockwise; held keys are summed.
+     */
+    float mixWheelInput(uint8_t wheel);
 };
 }  // namespace control
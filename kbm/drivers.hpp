@@ -21,6 +21,8 @@
 
 #include "tap/drivers.hpp"
 
+#include "communication/serial/virtual_remote.hpp"
+
 #ifdef ENV_UNIT_TESTS
 #include "control/mock_control_operator_interface.hpp"
 #else
@@ -34,9 +36,17 @@ class Drivers : public tap::Drivers
 #ifdef ENV_UNIT_TESTS
 public:
 #endif
+#if defined(PLATFORM_HOSTED) && !defined(ENV_UNIT_TESTS)
+    Drivers() : tap::Drivers(), virtualRemote(*this), controlOperatorInterface(virtualRemote) {}
+#else
     Drivers() : tap::Drivers(), controlOperatorInterface(remote) {}
+#endif
 
 public:
+#if defined(PLATFORM_HOSTED) && !defined(ENV_UNIT_TESTS)
+    communication::serial::VirtualRemote virtualRemote;
+#endif
+
 #ifdef ENV_UNIT_TESTS
     control::MockControlOperatorInterface controlOperatorInterface;
 #else
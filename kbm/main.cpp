@@ -84,6 +84,9 @@ static void initializeIo(Drivers *drivers)
     drivers->can.initialize();
     drivers->errorController.init();
     drivers->remote.initialize();
+#if defined(PLATFORM_HOSTED) && !defined(ENV_UNIT_TESTS)
+    drivers->virtualRemote.initialize();
+#endif
     drivers->mpu6500.init(IMU_SMAPLE_FREQUENCY, MAHONY_KP, MAHONY_KI);
     drivers->refSerial.initialize();
     drivers->terminalSerial.initialize();
@@ -95,6 +98,10 @@ static void updateIo(Drivers *drivers)
 {
     drivers->canRxHandler.pollCanData();
     drivers->refSerial.updateSerial();
+#if defined(PLATFORM_HOSTED) && !defined(ENV_UNIT_TESTS)
+    drivers->virtualRemote.read();
+#else
     drivers->remote.read();
+#endif
     drivers->mpu6500.read();
 }
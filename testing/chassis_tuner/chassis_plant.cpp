@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "chassis_plant.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using control::chassis::ChassisKinematics;
+
+namespace tuner
+{
+ChassisPlant::ChassisPlant(
+    const ChassisKinematics<NUM_WHEELS> &kinematics,
+    float gearRatio,
+    const ChassisPlantConfig &config)
+    : config(config),
+      gearRatio(gearRatio),
+      wheelJacobian(kinematics.getInverseMatrix()),
+      torqueToAcceleration()
+{
+    // Generalized mass: body mass plus the rotors' inertia reflected through G * J
+    double mass[3][3] = {
+        {config.massKg, 0, 0},
+        {0, config.massKg, 0},
+        {0, 0, config.yawInertiaKgM2}};
+    double reflected = config.rotorInertiaKgM2 * gearRatio * gearRatio;
+    for (const auto &row : wheelJacobian)
+    {
+        for (int r = 0; r < 3; r++)
+        {
+            for (int c = 0; c < 3; c++)
+            {
+                mass[r][c] += reflected * row[r] * row[c];
+            }
+        }
+    }
+
+    double cof[3][3] = {
+        {mass[1][1] * mass[2][2] - mass[1][2] * mass[2][1],
+         mass[0][2] * mass[2][1] - mass[0][1] * mass[2][2],
+         mass[0][1] * mass[1][2] - mass[0][2] * mass[1][1]},
+        {mass[1][2] * mass[2][0] - mass[1][0] * mass[2][2],
+         mass[0][0] * mass[2][2] - mass[0][2] * mass[2][0],
+         mass[0][2] * mass[1][0] - mass[0][0] * mass[1][2]},
+        {mass[1][0] * mass[2][1] - mass[1][1] * mass[2][0],
+         mass[0][1] * mass[2][0] - mass[0][0] * mass[2][1],
+         mass[0][0] * mass[1][1] - mass[0][1] * mass[1][0]}};
+    double det = mass[0][0] * cof[0][0] + mass[0][1] * cof[1][0] + mass[0][2] * cof[2][0];
+
+    for (int r = 0; r < 3; r++)
+    {
+        for (std::size_t i = 0; i < NUM_WHEELS; i++)
+        {
+            double sum = 0;
+            for (int c = 0; c < 3; c++)
+            {
+                sum += cof[r][c] / det * wheelJacobian[i][c];
+            }
+            torqueToAcceleration[r][i] = static_cast<float>(sum * gearRatio);
+        }
+    }
+}
+
+void ChassisPlant::setCurrentCommand(std::size_t wheel, float command)
+{
+    command = std::clamp<float>(command, -MAX_CURRENT_COMMAND, MAX_CURRENT_COMMAND);
+    currentCommandA[wheel] = std::trunc(command) * MAX_CURRENT_A / MAX_CURRENT_COMMAND;
+}
+
+void ChassisPlant::step(float dt)
+{
+    std::array<float, NUM_WHEELS> rotorTorque;
+    copperLossW = 0;
+
+    for (std::size_t i = 0; i < NUM_WHEELS; i++)
+    {
+        float speed = getRotorSpeed(i);
+
+        float backEmf = config.backEmfConstant * speed;
+        float current = std::clamp(
+            currentCommandA[i],
+            (-config.supplyVoltage - backEmf) / config.windingResistanceOhm,
+            (config.supplyVoltage - backEmf) / config.windingResistanceOhm);
+        copperLossW += current * current * config.windingResistanceOhm;
+
+        // Coulomb friction is smoothed through zero, so a wheel at rest does not chatter
+        rotorTorque[i] = config.torqueConstant * current - config.viscousFriction * speed -
+                         config.coulombFriction * std::tanh(speed);
+
+        rotorAngle[i] += static_cast<double>(speed) * dt;
+    }
+
+    float *axes[3] = {&twist.x, &twist.y, &twist.z};
+    for (int r = 0; r < 3; r++)
+    {
+        float acceleration = 0;
+        for (std::size_t i = 0; i < NUM_WHEELS; i++)
+        {
+            acceleration += torqueToAcceleration[r][i] * rotorTorque[i];
+        }
+        *axes[r] += acceleration * dt;
+    }
+}
+
+int64_t ChassisPlant::getEncoderUnwrapped(std::size_t wheel) const
+{
+    return static_cast<int64_t>(std::floor(rotorAngle[wheel] / (2 * M_PI) * ENCODER_RESOLUTION));
+}
+
+int16_t ChassisPlant::getReportedRpm(std::size_t wheel) const
+{
+    float rpm = std::round(getRotorSpeed(wheel) * 60.0f / (2 * static_cast<float>(M_PI)));
+    return static_cast<int16_t>(std::clamp(rpm, -32768.0f, 32767.0f));
+}
+
+float ChassisPlant::getRotorSpeed(std::size_t wheel) const
+{
+    const auto &row = wheelJacobian[wheel];
+    return gearRatio * (row[0] * twist.x + row[1] * twist.y + row[2] * twist.z);
+}
+}  // namespace tuner
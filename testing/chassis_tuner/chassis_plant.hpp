@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "control/chassis/chassis_kinematics.hpp"
+
+namespace tuner
+{
+/// Physical constants of the simulated robot. Motor constants match testing/motor_sim.py.
+struct ChassisPlantConfig
+{
+    float massKg{20.0f};
+    /// Moment of inertia about the vertical axis, in kg*m^2.
+    float yawInertiaKgM2{0.8f};
+    /// Rotor inertia, in kg*m^2. The gearbox and wheel are lumped into it.
+    float rotorInertiaKgM2{1.5e-5f};
+    /// N*m/A at the rotor, from 0.3 N*m/A at the gearbox output.
+    float torqueConstant{0.3f / (3591.0f / 187.0f)};
+    /// V per rotor rad/s, from a 482 RPM no load output speed at 24 V.
+    float backEmfConstant{24.0f / (482.0f * 3591.0f / 187.0f * 2 * 3.14159265f / 60.0f)};
+    float windingResistanceOhm{0.194f};
+    float supplyVoltage{24.0f};
+    /// Rotor friction, in N*m per rad/s.
+    float viscousFriction{2e-6f};
+    /// Rotor friction, in N*m.
+    float coulombFriction{4e-3f};
+};
+
+/**
+ * A mecanum chassis on four M3508 motors behind C620 current controllers.
+ *
+ * The wheels are assumed not to slip, so the body twist is the only state and the rotor speeds
+ * follow from it through the kinematics. Rotor inertia is reflected into the body's generalized
+ * mass, which couples the wheels the way the real chassis does: torque on one wheel accelerates
+ * all four. Each C620 tracks its commanded current until back-EMF leaves too little voltage
+ * headroom.
+ */
+class ChassisPlant
+{
+public:
+    static constexpr std::size_t NUM_WHEELS = 4;
+
+    /// C620 current command range, mapped linearly onto +-20 A.
+    static constexpr int16_t MAX_CURRENT_COMMAND = 16384;
+    static constexpr float MAX_CURRENT_A = 20.0f;
+    static constexpr int ENCODER_RESOLUTION = 8192;
+
+    ChassisPlant(
+        const control::chassis::ChassisKinematics<NUM_WHEELS> &kinematics,
+        float gearRatio,
+        const ChassisPlantConfig &config);
+
+    /// Sets a wheel's C620 current command, clamped to +-MAX_CURRENT_COMMAND.
+    void setCurrentCommand(std::size_t wheel, float command);
+
+    /// Advances the simulation by `dt` seconds.
+    void step(float dt);
+
+    const control::chassis::Twist &getTwist() const { return twist; }
+
+    /// @return the unwrapped encoder count, as DjiMotor::getEncoderUnwrapped reports it.
+    int64_t getEncoderUnwrapped(std::size_t wheel) const;
+
+    /// @return the integer rotor RPM the C620 reports.
+    int16_t getReportedRpm(std::size_t wheel) const;
+
+    /// @return resistive losses in all windings over the last step, in W.
+    float getCopperLossW() const { return copperLossW; }
+
+private:
+    float getRotorSpeed(std::size_t wheel) const;
+
+    const ChassisPlantConfig config;
+    const float gearRatio;
+    const control::chassis::ChassisKinematics<NUM_WHEELS>::InverseMatrix wheelJacobian;
+
+    /// Maps rotor torques to body acceleration, the inverse generalized mass times the
+    /// transposed Jacobian.
+    std::array<std::array<float, NUM_WHEELS>, 3> torqueToAcceleration;
+
+    control::chassis::Twist twist{};
+    std::array<float, NUM_WHEELS> currentCommandA{};
+    std::array<double, NUM_WHEELS> rotorAngle{};
+    float copperLossW{0};
+};
+}  // namespace tuner
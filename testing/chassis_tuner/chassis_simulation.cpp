@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "chassis_simulation.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using control::algorithms::WheelVelocityEstimator;
+using control::chassis::GEAR_RATIO;
+using control::chassis::makeMecanumGeometry;
+using control::chassis::MAX_WHEELSPEED_RPM;
+using control::chassis::Twist;
+using control::chassis::WHEEL_DIAMETER_M;
+
+namespace tuner
+{
+ChassisSimulation::ChassisSimulation(
+    const Candidate &candidate,
+    const ChassisPlantConfig &plantConfig,
+    float wheelBaseM,
+    float trackWidthM)
+    : candidate(candidate),
+      plantConfig(plantConfig),
+      kinematics(makeMecanumGeometry(wheelBaseM, trackWidthM, WHEEL_DIAMETER_M / 2, GEAR_RATIO)),
+      twistToRpm(kinematics, kinematics.getShaftRpmPerWheelRadPerSec(), MAX_WHEELSPEED_RPM)
+{
+}
+
+ManeuverResult ChassisSimulation::run(const Maneuver &maneuver) const
+{
+    Twist target = maneuver.target;
+    float scale = std::min(1.0f, twistToRpm.getMaxScaleAlong(target));
+    target = {target.x * scale, target.y * scale, target.z * scale};
+    float targetNormSquared = target.x * target.x + target.y * target.y + target.z * target.z;
+
+    ChassisPlant plant(kinematics, GEAR_RATIO, plantConfig);
+    const auto setpoints = twistToRpm.apply(target);
+
+    std::array<Pid, ChassisPlant::NUM_WHEELS> pids{
+        Pid(candidate.wheelVelocityPidConfig),
+        Pid(candidate.wheelVelocityPidConfig),
+        Pid(candidate.wheelVelocityPidConfig),
+        Pid(candidate.wheelVelocityPidConfig)};
+    std::array<WheelVelocityEstimator, ChassisPlant::NUM_WHEELS> estimators{
+        WheelVelocityEstimator(estimatorConfig),
+        WheelVelocityEstimator(estimatorConfig),
+        WheelVelocityEstimator(estimatorConfig),
+        WheelVelocityEstimator(estimatorConfig)};
+    std::array<float, ChassisPlant::NUM_WHEELS> slewedSetpoints{};
+
+    std::array<int64_t, ChassisPlant::NUM_WHEELS> feedbackEncoder{};
+    std::array<int16_t, ChassisPlant::NUM_WHEELS> feedbackRpm{};
+    uint32_t feedbackUs = 0;
+
+    const uint32_t durationUs = static_cast<uint32_t>(maneuver.durationS * 1e6f);
+    const uint32_t settledUs = durationUs - durationUs / 5;
+    const float dt = PLANT_STEP_US / 1e6f;
+
+    float riseStartS = -1;
+    float riseEndS = -1;
+    float peak = 0;
+    float settledErrorSum = 0;
+    uint32_t settledSamples = 0;
+    float energyJ = 0;
+
+    for (uint32_t now = 0; now < durationUs; now += PLANT_STEP_US)
+    {
+        if (now % FEEDBACK_PERIOD_US == 0)
+        {
+            for (std::size_t ii = 0; ii < ChassisPlant::NUM_WHEELS; ii++)
+            {
+                feedbackEncoder[ii] = plant.getEncoderUnwrapped(ii);
+                feedbackRpm[ii] = plant.getReportedRpm(ii);
+            }
+            feedbackUs = now;
+        }
+
+        if (now % CONTROL_PERIOD_US == 0)
+        {
+            float maxStep = candidate.setpointSlewRpmPerSec * CONTROL_PERIOD_US / 1e6f;
+            for (std::size_t ii = 0; ii < ChassisPlant::NUM_WHEELS; ii++)
+            {
+                estimators[ii].update(feedbackEncoder[ii], feedbackRpm[ii], feedbackUs);
+
+                slewedSetpoints[ii] =
+                    candidate.setpointSlewRpmPerSec <= 0
+                        ? setpoints[ii]
+                        : slewedSetpoints[ii] +
+                              std::clamp(setpoints[ii] - slewedSetpoints[ii], -maxStep, maxStep);
+
+                pids[ii].update(slewedSetpoints[ii] - estimators[ii].getRpm());
+                plant.setCurrentCommand(
+                    ii,
+                    pids[ii].getValue() +
+                        candidate.wheelVelocityFeedforward * slewedSetpoints[ii]);
+            }
+        }
+
+        plant.step(dt);
+        energyJ += plant.getCopperLossW() * dt;
+
+        const Twist &twist = plant.getTwist();
+        float progress =
+            (twist.x * target.x + twist.y * target.y + twist.z * target.z) / targetNormSquared;
+        float timeS = (now + PLANT_STEP_US) / 1e6f;
+
+        if (riseStartS < 0 && progress >= 0.1f) riseStartS = timeS;
+        if (riseEndS < 0 && progress >= 0.9f) riseEndS = timeS;
+        peak = std::max(peak, progress);
+
+        if (now >= settledUs)
+        {
+            settledErrorSum += std::fabs(1 - progress);
+            settledSamples++;
+        }
+    }
+
+    return ManeuverResult{
+        .riseTimeS = riseEndS < 0 ? maneuver.durationS : riseEndS - riseStartS,
+        .overshoot = std::max(0.0f, peak - 1),
+        .steadyStateError = settledErrorSum / std::max(1u, settledSamples),
+        .energyJ = energyJ,
+    };
+}
+}  // namespace tuner
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "control/algorithms/wheel_velocity_estimator.hpp"
+#include "control/chassis/chassis_constants.hpp"
+#include "control/chassis/chassis_kinematics.hpp"
+#include "control/chassis/twist_to_rpm_transform.hpp"
+
+#include "chassis_plant.hpp"
+#include "pid.hpp"
+
+namespace tuner
+{
+/// The ChassisConfig fields being tuned.
+struct Candidate
+{
+    Pid::Parameter wheelVelocityPidConfig;
+    float wheelVelocityFeedforward;
+    float setpointSlewRpmPerSec;
+};
+
+/// A step from rest to a constant twist.
+struct Maneuver
+{
+    const char *name;
+    control::chassis::Twist target;
+    float durationS;
+};
+
+/// Response to one maneuver, measured along the target twist.
+struct ManeuverResult
+{
+    /// Time from 10% to 90% of the target, or the whole maneuver if 90% is never reached.
+    float riseTimeS;
+    /// Peak beyond the target, as a fraction of it.
+    float overshoot;
+    /// Mean distance from the target over the last fifth of the maneuver, as a fraction of it.
+    float steadyStateError;
+    /// Resistive losses in the windings over the maneuver, in J.
+    float energyJ;
+};
+
+/**
+ * Runs a candidate on the simulated chassis the way ChassisSubsystem::refresh would: feedback
+ * arrives at the C620's 1 kHz, and each 2 ms control tick filters it through a
+ * WheelVelocityEstimator, slew limits the setpoints and runs the velocity PID plus feedforward.
+ *
+ * ChassisSubsystem needs taproot's drivers, so its refresh is mirrored here rather than reused.
+ * The kinematics, twist transform and velocity estimator are the robot's own code.
+ */
+class ChassisSimulation
+{
+public:
+    static constexpr uint32_t CONTROL_PERIOD_US = 2000;
+    static constexpr uint32_t FEEDBACK_PERIOD_US = 1000;
+    static constexpr uint32_t PLANT_STEP_US = 100;
+
+    ChassisSimulation(
+        const Candidate &candidate,
+        const ChassisPlantConfig &plantConfig,
+        float wheelBaseM,
+        float trackWidthM);
+
+    /// Runs `maneuver` from rest. The target is scaled back into the wheels' speed envelope.
+    ManeuverResult run(const Maneuver &maneuver) const;
+
+private:
+    using Kinematics = control::chassis::ChassisKinematics<ChassisPlant::NUM_WHEELS>;
+
+    const Candidate candidate;
+    const ChassisPlantConfig plantConfig;
+    const Kinematics kinematics;
+    const control::chassis::TwistToRpmTransform twistToRpm;
+    const control::algorithms::WheelVelocityEstimatorConfig estimatorConfig{};
+};
+}  // namespace tuner
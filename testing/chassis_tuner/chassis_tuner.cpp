@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * Sweeps ChassisSubsystem's wheel velocity PID, feedforward and setpoint slew over a grid, scores
+ * every candidate on a forward step, a strafe and a spin in the hosted chassis simulation, and
+ * prints the best as a ChassisConfig ready to paste into standard.cpp.
+ *
+ * Candidates are independent, so each is one task on a work-stealing pool with a worker per
+ * hardware thread.
+ *
+ * build, from the repository root:
+ *     g++ -std=c++20 -O2 -pthread -Icontroller -o chassis_tuner \
+ *         testing/chassis_tuner/{chassis_tuner,chassis_simulation,chassis_plant}.cpp \
+ *         testing/chassis_tuner/work_stealing_pool.cpp \
+ *         controller/control/algorithms/wheel_velocity_estimator.cpp
+ *
+ * usage:
+ *     ./chassis_tuner [--threads N] [--top N] [--coarse]
+ *                     [--weights RISE OVERSHOOT ERROR ENERGY]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+#include "chassis_simulation.hpp"
+#include "work_stealing_pool.hpp"
+
+using namespace tuner;
+
+namespace
+{
+/// Matches the wheelVelocityPidConfig maxOutput in standard.cpp.
+constexpr float MAX_PID_OUTPUT = 16'000;
+constexpr float WHEEL_BASE_M = 0.4f;
+constexpr float TRACK_WIDTH_M = 0.4f;
+
+constexpr Maneuver MANEUVERS[] = {
+    {"step", {1.2f, 0, 0}, 0.8f},
+    {"strafe", {0, 1.2f, 0}, 0.8f},
+    {"spin", {0, 0, 3.0f}, 0.8f},
+};
+constexpr std::size_t NUM_MANEUVERS = std::size(MANEUVERS);
+
+/// Cost of each metric, summed over the maneuvers into a candidate's score. Lower is better.
+struct ScoreWeights
+{
+    /// Per second of rise time.
+    float riseTime{10};
+    /// Per unit of overshoot fraction.
+    float overshoot{5};
+    /// Per unit of steady state error fraction.
+    float steadyStateError{10};
+    /// Per J of copper loss.
+    float energy{0.01f};
+};
+
+struct Evaluation
+{
+    Candidate candidate;
+    ManeuverResult results[NUM_MANEUVERS];
+    float score;
+};
+
+std::vector<Candidate> makeCandidates(bool coarse)
+{
+    std::vector<float> kps = {5, 10, 15, 20, 30, 40, 60, 80};
+    std::vector<float> kis = {0, 0.1f, 0.25f, 0.5f, 1, 2};
+    std::vector<float> kds = {0, 2, 5};
+    std::vector<float> feedforwards = {0, 0.25f, 0.5f, 1};
+    std::vector<float> slews = {0, 20'000, 40'000, 80'000};
+
+    if (coarse)
+    {
+        kps = {10, 20, 40};
+        kis = {0, 0.5f};
+        kds = {0};
+        feedforwards = {0, 0.5f};
+        slews = {0, 40'000};
+    }
+
+    std::vector<Candidate> candidates;
+    for (float kp : kps)
+    {
+        for (float ki : kis)
+        {
+            for (float kd : kds)
+            {
+                for (float feedforward : feedforwards)
+                {
+                    for (float slew : slews)
+                    {
+                        // Enough error sum for the integral alone to reach full output
+                        float maxErrorSum = ki > 0 ? MAX_PID_OUTPUT / ki : 0;
+                        candidates.push_back(Candidate{
+                            .wheelVelocityPidConfig = {kp, ki, kd, maxErrorSum, MAX_PID_OUTPUT},
+                            .wheelVelocityFeedforward = feedforward,
+                            .setpointSlewRpmPerSec = slew,
+                        });
+                    }
+                }
+            }
+        }
+    }
+    return candidates;
+}
+
+Evaluation evaluate(const Candidate &candidate, const ScoreWeights &weights)
+{
+    ChassisSimulation simulation(candidate, ChassisPlantConfig{}, WHEEL_BASE_M, TRACK_WIDTH_M);
+
+    Evaluation evaluation{.candidate = candidate, .results = {}, .score = 0};
+    for (std::size_t ii = 0; ii < NUM_MANEUVERS; ii++)
+    {
+        const ManeuverResult &result = evaluation.results[ii] = simulation.run(MANEUVERS[ii]);
+        evaluation.score += weights.riseTime * result.riseTimeS +
+                            weights.overshoot * result.overshoot +
+                            weights.steadyStateError * result.steadyStateError +
+                            weights.energy * result.energyJ;
+    }
+    return evaluation;
+}
+
+void printEvaluation(std::size_t rank, const Evaluation &evaluation)
+{
+    const Candidate &candidate = evaluation.candidate;
+    std::printf(
+        "%3zu  score %7.3f  kp %5g ki %5g kd %3g ff %5g slew %6g\n",
+        rank,
+        evaluation.score,
+        candidate.wheelVelocityPidConfig.kp,
+        candidate.wheelVelocityPidConfig.ki,
+        candidate.wheelVelocityPidConfig.kd,
+        candidate.wheelVelocityFeedforward,
+        candidate.setpointSlewRpmPerSec);
+
+    for (std::size_t ii = 0; ii < NUM_MANEUVERS; ii++)
+    {
+        const ManeuverResult &result = evaluation.results[ii];
+        std::printf(
+            "       %-6s rise %6.1f ms  overshoot %5.1f%%  error %5.2f%%  energy %6.1f J\n",
+            MANEUVERS[ii].name,
+            result.riseTimeS * 1e3f,
+            result.overshoot * 100,
+            result.steadyStateError * 100,
+            result.energyJ);
+    }
+}
+
+void printChassisConfig(const Candidate &candidate)
+{
+    const Pid::Parameter &pid = candidate.wheelVelocityPidConfig;
+    std::printf(
+        "\nchassis::ChassisConfig{\n"
+        "        .leftFrontId = MotorId::MOTOR2,\n"
+        "        .leftBackId = MotorId::MOTOR3,\n"
+        "        .rightBackId = MotorId::MOTOR4,\n"
+        "        .rightFrontId = MotorId::MOTOR1,\n"
+        "        .canBus = CanBus::CAN_BUS1,\n"
+        "        .wheelVelocityPidConfig = modm::Pid<float>::Parameter(%g, %g, %g, %g, %g),\n"
+        "        .motorTimeoutUs = 10'000,\n"
+        "        .wheelBaseM = %gf,\n"
+        "        .trackWidthM = %gf,\n"
+        "        .wheelVelocityFeedforward = %g,\n"
+        "        .setpointSlewRpmPerSec = %g,\n"
+        "}\n",
+        pid.kp,
+        pid.ki,
+        pid.kd,
+        pid.maxErrorSum,
+        pid.maxOutput,
+        WHEEL_BASE_M,
+        TRACK_WIDTH_M,
+        candidate.wheelVelocityFeedforward,
+        candidate.setpointSlewRpmPerSec);
+}
+
+[[noreturn]] void usage(const char *program)
+{
+    std::fprintf(
+        stderr,
+        "usage: %s [--threads N] [--top N] [--coarse] "
+        "[--weights RISE OVERSHOOT ERROR ENERGY]\n",
+        program);
+    std::exit(2);
+}
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    unsigned numThreads = 0;
+    std::size_t top = 5;
+    bool coarse = false;
+    ScoreWeights weights;
+
+    for (int ii = 1; ii < argc; ii++)
+    {
+        auto needs = [&](int count) {
+            if (ii + count >= argc) usage(argv[0]);
+        };
+
+        if (std::strcmp(argv[ii], "--threads") == 0)
+        {
+            needs(1);
+            numThreads = std::strtoul(argv[++ii], nullptr, 10);
+        }
+        else if (std::strcmp(argv[ii], "--top") == 0)
+        {
+            needs(1);
+            top = std::strtoul(argv[++ii], nullptr, 10);
+        }
+        else if (std::strcmp(argv[ii], "--coarse") == 0)
+        {
+            coarse = true;
+        }
+        else if (std::strcmp(argv[ii], "--weights") == 0)
+        {
+            needs(4);
+            weights.riseTime = std::strtof(argv[++ii], nullptr);
+            weights.overshoot = std::strtof(argv[++ii], nullptr);
+            weights.steadyStateError = std::strtof(argv[++ii], nullptr);
+            weights.energy = std::strtof(argv[++ii], nullptr);
+        }
+        else
+        {
+            usage(argv[0]);
+        }
+    }
+
+    const std::vector<Candidate> candidates = makeCandidates(coarse);
+    std::vector<Evaluation> evaluations(candidates.size());
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        WorkStealingPool pool(numThreads);
+        std::fprintf(
+            stderr,
+            "evaluating %zu candidates on %u threads\n",
+            candidates.size(),
+            pool.getNumThreads());
+
+        for (std::size_t ii = 0; ii < candidates.size(); ii++)
+        {
+            // Each task owns its slot, so results need no locking
+            pool.submit([&, ii] { evaluations[ii] = evaluate(candidates[ii], weights); });
+        }
+        pool.wait();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::fprintf(stderr, "done in %.1f s\n\n", elapsed.count());
+
+    std::vector<std::size_t> order(evaluations.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return evaluations[a].score < evaluations[b].score;
+    });
+
+    for (std::size_t rank = 0; rank < std::min(top, order.size()); rank++)
+    {
+        printEvaluation(rank + 1, evaluations[order[rank]]);
+    }
+
+    if (!order.empty())
+    {
+        printChassisConfig(evaluations[order.front()].candidate);
+    }
+    return 0;
+}
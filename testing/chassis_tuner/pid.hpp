@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+
+namespace tuner
+{
+/**
+ * A copy of modm::Pid<float>'s update rule, so candidates behave as they will on the robot
+ * without pulling modm into a hosted tool. The error sum is clamped to `maxErrorSum` and only
+ * committed while the output is not saturated.
+ */
+class Pid
+{
+public:
+    /// Same field order as modm::Pid<float>::Parameter.
+    struct Parameter
+    {
+        float kp;
+        float ki;
+        float kd;
+        float maxErrorSum;
+        float maxOutput;
+    };
+
+    explicit Pid(const Parameter &parameter) : parameter(parameter) {}
+
+    void update(float input)
+    {
+        float tmpErrorSum =
+            std::clamp(errorSum + input, -parameter.maxErrorSum, parameter.maxErrorSum);
+
+        float tmp = parameter.kp * input + parameter.ki * tmpErrorSum +
+                    parameter.kd * (input - lastError);
+
+        bool limitation = tmp > parameter.maxOutput || tmp < -parameter.maxOutput;
+        output = std::clamp(tmp, -parameter.maxOutput, parameter.maxOutput);
+
+        if (!limitation)
+        {
+            errorSum = tmpErrorSum;
+        }
+        lastError = input;
+    }
+
+    float getValue() const { return output; }
+
+    void reset()
+    {
+        errorSum = 0;
+        lastError = 0;
+        output = 0;
+    }
+
+private:
+    Parameter parameter;
+    float errorSum{0};
+    float lastError{0};
+    float output{0};
+};
+}  // namespace tuner
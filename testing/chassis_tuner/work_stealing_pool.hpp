@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2020-2022 Advanced Robotics at the University of Washington <robomstr@uw.edu>
+ *
+ * This file is part of aruw-edu.
+ *
+ * aruw-edu is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * aruw-edu is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with aruw-edu.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tuner
+{
+/**
+ * A fixed set of worker threads, each with its own task deque.
+ *
+ * Submitted tasks are dealt round robin onto the deques. A worker runs its own deque newest
+ * first and, once that is empty, steals the oldest task from another worker's deque, so a worker
+ * that drew cheap tasks keeps the others' backlogs short instead of going idle.
+ */
+class WorkStealingPool
+{
+public:
+    /**
+     * @param[in] numThreads number of workers. 0 uses one per hardware thread.
+     */
+    explicit WorkStealingPool(unsigned numThreads = 0);
+
+    /// Waits for queued tasks to finish, then joins the workers.
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    void submit(std::function<void()> task);
+
+    /// Blocks until every submitted task has finished.
+    void wait();
+
+    unsigned getNumThreads() const { return static_cast<unsigned>(workers.size()); }
+
+private:
+    using Task = std::function<void()>;
+
+    struct TaskQueue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void workerLoop(unsigned index);
+
+    bool popLocal(unsigned index, Task &task);
+
+    bool steal(unsigned thief, Task &task);
+
+    std::vector<std::unique_ptr<TaskQueue>> queues;
+    std::vector<std::thread> workers;
+
+    /// Tasks submitted but not yet taken by a worker.
+    std::atomic<std::size_t> queued{0};
+    /// Tasks submitted but not yet finished.
+    std::atomic<std::size_t> unfinished{0};
+    std::atomic<unsigned> nextQueue{0};
+    bool stopping{false};
+
+    std::mutex stateMutex;
+    std::condition_variable workAvailable;
+    std::condition_variable allFinished;
+};
+}  // namespace tuner
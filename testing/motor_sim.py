@@ -0,0 +1,196 @@
+"""
+Simulates DJI C620 speed controllers driving M3508 motors on a SocketCAN interface, so the hosted
+controller build can run closed loop without hardware.
+
+setup (once per boot):
+    sudo modprobe vcan
+    sudo ip link add dev vcan0 type vcan
+    sudo ip link set up vcan0
+
+usage:
+    python3 motor_sim.py [--interface vcan0] [--motors 1 2 3 4] [--feedback-hz 1000]
+
+Each simulated controller listens for its current command in the 0x200 (motors 1-4) or 0x1FF
+(motors 5-8) frame and answers with a feedback frame on 0x200 + motor id at the C620's 1 kHz rate,
+encoded exactly like the real controller: big endian rotor angle (0-8191), rotor RPM and actual
+current, followed by the temperature.
+"""
+
+import argparse
+import math
+import select
+import socket
+import struct
+import sys
+import time
+
+
+CAN_FRAME_FORMAT = "=IB3x8s"
+CAN_FRAME_SIZE = struct.calcsize(CAN_FRAME_FORMAT)
+
+COMMAND_ID_LOW = 0x200
+COMMAND_ID_HIGH = 0x1FF
+FEEDBACK_ID_BASE = 0x200
+
+ENCODER_RESOLUTION = 8192
+# C620 current command range, mapped linearly onto +-20 A
+MAX_CURRENT_COMMAND = 16384
+MAX_CURRENT_A = 20.0
+# The C620 stops driving a motor whose command is older than this
+COMMAND_TIMEOUT_S = 0.1
+
+
+class M3508:
+    """
+    Rotor of an M3508 behind a C620 current loop. The C620 tracks the commanded current until
+    back-EMF leaves too little voltage headroom, so the achievable current falls off with speed.
+    """
+
+    TORQUE_CONSTANT = 0.3 / (3591 / 187)  # N*m/A at the rotor, from 0.3 N*m/A at the output
+    BACK_EMF_CONSTANT = 24.0 / (482 * 3591 / 187 * 2 * math.pi / 60)  # V per rad/s, 482 RPM no load
+    WINDING_RESISTANCE = 0.194  # ohm
+    SUPPLY_VOLTAGE = 24.0
+    # Rotor plus a quarter of a 20 kg robot on 38 mm wheels, reflected through the 19:1 gearbox
+    INERTIA = 1.5e-5 + 5.0 * 0.038**2 / 19.0**2  # kg*m^2
+    VISCOUS_FRICTION = 2e-6  # N*m per rad/s
+    COULOMB_FRICTION = 4e-3  # N*m
+
+    def __init__(self):
+        self.angle = 0.0  # rad
+        self.velocity = 0.0  # rad/s
+        self.current = 0.0  # A
+        self.commanded_current = 0.0  # A
+        self.last_command_time = 0.0
+        self.temperature = 30.0
+
+    def command(self, raw: int, now: float) -> None:
+        self.commanded_current = raw * MAX_CURRENT_A / MAX_CURRENT_COMMAND
+        self.last_command_time = now
+
+    def step(self, dt: float, now: float) -> None:
+        desired = self.commanded_current
+        if now - self.last_command_time > COMMAND_TIMEOUT_S:
+            desired = 0.0
+
+        back_emf = self.BACK_EMF_CONSTANT * self.velocity
+        headroom_high = (self.SUPPLY_VOLTAGE - back_emf) / self.WINDING_RESISTANCE
+        headroom_low = (-self.SUPPLY_VOLTAGE - back_emf) / self.WINDING_RESISTANCE
+        self.current = min(max(desired, headroom_low), headroom_high)
+
+        torque = self.TORQUE_CONSTANT * self.current - self.VISCOUS_FRICTION * self.velocity
+        if abs(self.velocity) > 1e-3:
+            torque -= math.copysign(self.COULOMB_FRICTION, self.velocity)
+        elif abs(torque) <= self.COULOMB_FRICTION:
+            torque = 0.0
+
+        self.velocity += torque / self.INERTIA * dt
+        self.angle = (self.angle + self.velocity * dt) % (2 * math.pi)
+        self.temperature += (self.current**2 * self.WINDING_RESISTANCE * 1e-4 -
+                             (self.temperature - 30.0) * 1e-3) * dt
+
+    def feedback(self) -> bytes:
+        encoder = int(self.angle / (2 * math.pi) * ENCODER_RESOLUTION) % ENCODER_RESOLUTION
+        rpm = int(round(self.velocity * 60 / (2 * math.pi)))
+        current = int(round(self.current * MAX_CURRENT_COMMAND / MAX_CURRENT_A))
+        return struct.pack(
+            ">HhhBx",
+            encoder,
+            max(-32768, min(32767, rpm)),
+            max(-32768, min(32767, current)),
+            int(self.temperature))
+
+
+def open_bus(interface: str) -> socket.socket:
+    bus = socket.socket(socket.AF_CAN, socket.SOCK_RAW, socket.CAN_RAW)
+    bus.bind((interface,))
+    bus.setblocking(False)
+    return bus
+
+
+def handle_command(frame: bytes, motors: dict[int, M3508], now: float) -> None:
+    can_id, length, data = struct.unpack(CAN_FRAME_FORMAT, frame)
+    can_id &= socket.CAN_SFF_MASK
+    if length != 8:
+        return
+
+    if can_id == COMMAND_ID_LOW:
+        first_motor = 1
+    elif can_id == COMMAND_ID_HIGH:
+        first_motor = 5
+    else:
+        return
+
+    for offset, raw in enumerate(struct.unpack(">4h", data)):
+        motor = motors.get(first_motor + offset)
+        if motor is not None:
+            motor.command(raw, now)
+
+
+def run(interface: str, motor_ids: list[int], feedback_hz: float) -> None:
+    bus = open_bus(interface)
+    motors = {motor_id: M3508() for motor_id in motor_ids}
+    period = 1.0 / feedback_hz
+
+    last_step = time.monotonic()
+    next_feedback = last_step + period
+    while True:
+        timeout = max(0.0, next_feedback - time.monotonic())
+        readable, _, _ = select.select([bus], [], [], timeout)
+        now = time.monotonic()
+
+        if readable:
+            while True:
+                try:
+                    handle_command(bus.recv(CAN_FRAME_SIZE), motors, now)
+                except BlockingIOError:
+                    break
+
+        if now < next_feedback:
+            continue
+
+        for motor in motors.values():
+            motor.step(now - last_step, now)
+        last_step = now
+
+        for motor_id, motor in motors.items():
+            frame = struct.pack(CAN_FRAME_FORMAT, FEEDBACK_ID_BASE + motor_id, 8, motor.feedback())
+            try:
+                bus.send(frame)
+            except (BlockingIOError, OSError):
+                # Dropped like a frame that lost arbitration too often; the next one follows
+                pass
+
+        # Skip missed periods instead of bursting to catch up, like the controller would
+        next_feedback += period * max(1, math.ceil((now - next_feedback) / period))
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Simulate C620/M3508 motors on SocketCAN.")
+    parser.add_argument("--interface", default="vcan0", help="SocketCAN interface to use")
+    parser.add_argument(
+        "--motors",
+        type=int,
+        nargs="+",
+        default=[1, 2, 3, 4],
+        choices=range(1, 9),
+        metavar="ID",
+        help="motor ids (1-8) to simulate")
+    parser.add_argument(
+        "--feedback-hz",
+        type=float,
+        default=1000.0,
+        help="feedback frames per second per motor")
+    args = parser.parse_args()
+
+    try:
+        run(args.interface, args.motors, args.feedback_hz)
+    except OSError as error:
+        print(f"motor_sim: error: {args.interface}: {error}", file=sys.stderr)
+        return 1
+    except KeyboardInterrupt:
+        pass
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,256 @@
+"""
+Feeds the hosted build's virtual remote with DR16 frames over UDP, from the keyboard, a joystick
+or a script.
+
+usage:
+    python3 remote_bridge.py keyboard [--port 7001]
+    python3 remote_bridge.py evdev /dev/input/eventN
+    python3 remote_bridge.py replay script.txt [--loop]
+
+keyboard:
+    Keys are sent as DR16 key bits, for the kbm build, and also move the sticks, for the
+    controller build: W/S and A/D move the left stick, J/L the right stick horizontally.
+    Terminals only report key presses, so a key counts as held until it has not repeated for
+    --hold seconds. Ctrl-C quits.
+
+evdev:
+    Reads a joystick through python-evdev (pip install evdev). ABS_X/ABS_Y drive the left stick
+    and ABS_RX/ABS_RY the right stick.
+
+replay:
+    Each non-empty line not starting with '#' is
+        <time_s> <left_h> <left_v> <right_h> <right_v> [KEY ...]
+    with stick positions in [-1, 1] and keys named as in Remote::Key (W, S, A, D, SHIFT, ...).
+    The input holds from its time until the next line's, so results are repeatable.
+
+Frames go out at the DR16's ~70 Hz unless --rate says otherwise.
+"""
+
+import argparse
+import os
+import select
+import socket
+import sys
+import time
+
+
+FRAME_LENGTH = 18
+CHANNEL_CENTER = 1024
+STICK_MAX_VALUE = 660
+
+# Bit positions of Remote::Key
+KEYS = ["W", "S", "A", "D", "SHIFT", "CTRL", "Q", "E", "R", "F", "G", "Z", "X", "C", "V", "B"]
+
+SWITCH_STATES = {"UP": 1, "DOWN": 2, "MID": 3}
+
+
+class RemoteState:
+    def __init__(self):
+        self.right_h = 0.0
+        self.right_v = 0.0
+        self.left_h = 0.0
+        self.left_v = 0.0
+        self.wheel = 0.0
+        self.left_switch = SWITCH_STATES["MID"]
+        self.right_switch = SWITCH_STATES["MID"]
+        self.mouse = (0, 0, 0)
+        self.mouse_l = False
+        self.mouse_r = False
+        self.keys = set()
+
+
+def encode_frame(state: RemoteState) -> bytes:
+    def channel(position: float) -> int:
+        position = max(-1.0, min(1.0, position))
+        return CHANNEL_CENTER + int(round(position * STICK_MAX_VALUE))
+
+    ch0 = channel(state.right_h)
+    ch1 = channel(state.right_v)
+    ch2 = channel(state.left_h)
+    ch3 = channel(state.left_v)
+    wheel = channel(state.wheel)
+    keys = sum(1 << KEYS.index(key) for key in state.keys)
+
+    frame = bytearray(FRAME_LENGTH)
+    frame[0] = ch0 & 0xFF
+    frame[1] = (ch0 >> 8 | ch1 << 3) & 0xFF
+    frame[2] = (ch1 >> 5 | ch2 << 6) & 0xFF
+    frame[3] = (ch2 >> 2) & 0xFF
+    frame[4] = (ch2 >> 10 | ch3 << 1) & 0xFF
+    frame[5] = (ch3 >> 7 | state.right_switch << 4 | state.left_switch << 6) & 0xFF
+    for offset, value in zip((6, 8, 10), state.mouse):
+        frame[offset:offset + 2] = (value & 0xFFFF).to_bytes(2, "little")
+    frame[12] = int(state.mouse_l)
+    frame[13] = int(state.mouse_r)
+    frame[14:16] = keys.to_bytes(2, "little")
+    frame[16:18] = wheel.to_bytes(2, "little")
+    return bytes(frame)
+
+
+class Sender:
+    def __init__(self, host: str, port: int, rate: float):
+        self.sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self.address = (host, port)
+        self.period = 1.0 / rate
+        self.next_send = time.monotonic()
+
+    def wait(self) -> float:
+        """Sleeps until the next frame is due and returns the time."""
+        self.next_send += self.period
+        delay = self.next_send - time.monotonic()
+        if delay > 0:
+            time.sleep(delay)
+        else:
+            self.next_send = time.monotonic()
+        return time.monotonic()
+
+    def send(self, state: RemoteState) -> None:
+        self.sock.sendto(encode_frame(state), self.address)
+
+
+def run_keyboard(sender: Sender, hold: float) -> None:
+    import termios
+    import tty
+
+    stick_keys = {
+        "W": ("left_v", 1.0),
+        "S": ("left_v", -1.0),
+        "A": ("left_h", -1.0),
+        "D": ("left_h", 1.0),
+        "J": ("right_h", -1.0),
+        "L": ("right_h", 1.0),
+    }
+
+    fd = sys.stdin.fileno()
+    saved = termios.tcgetattr(fd)
+    tty.setcbreak(fd)
+    last_seen = {}
+    try:
+        while True:
+            now = sender.wait()
+            while select.select([sys.stdin], [], [], 0)[0]:
+                char = os.read(fd, 1).decode(errors="ignore").upper()
+                if char == "\x03":
+                    return
+                last_seen[char] = now
+
+            held = {key for key, seen in last_seen.items() if now - seen < hold}
+            state = RemoteState()
+            state.keys = held & set(KEYS)
+            for key in held:
+                if key in stick_keys:
+                    axis, value = stick_keys[key]
+                    setattr(state, axis, getattr(state, axis) + value)
+            sender.send(state)
+    finally:
+        termios.tcsetattr(fd, termios.TCSADRAIN, saved)
+
+
+def run_evdev(sender: Sender, device_path: str) -> None:
+    try:
+        import evdev
+    except ImportError:
+        raise SystemExit("remote_bridge: error: evdev mode needs 'pip install evdev'")
+
+    device = evdev.InputDevice(device_path)
+    axes = {
+        evdev.ecodes.ABS_X: ("left_h", 1.0),
+        evdev.ecodes.ABS_Y: ("left_v", -1.0),
+        evdev.ecodes.ABS_RX: ("right_h", 1.0),
+        evdev.ecodes.ABS_RY: ("right_v", -1.0),
+    }
+    ranges = {code: device.absinfo(code) for code in axes if code in dict(
+        device.capabilities().get(evdev.ecodes.EV_ABS, []))}
+
+    state = RemoteState()
+    while True:
+        sender.wait()
+        while True:
+            try:
+                event = device.read_one()
+            except BlockingIOError:
+                event = None
+            if event is None:
+                break
+            if event.type != evdev.ecodes.EV_ABS or event.code not in ranges:
+                continue
+            info = ranges[event.code]
+            center = (info.max + info.min) / 2
+            position = (event.value - center) / ((info.max - info.min) / 2)
+            axis, sign = axes[event.code]
+            setattr(state, axis, sign * position)
+        sender.send(state)
+
+
+def parse_script(path: str) -> list[tuple[float, RemoteState]]:
+    steps = []
+    with open(path) as script:
+        for number, line in enumerate(script, 1):
+            fields = line.split()
+            if not fields or fields[0].startswith("#"):
+                continue
+            try:
+                state = RemoteState()
+                state.left_h, state.left_v, state.right_h, state.right_v = map(float, fields[1:5])
+                state.keys = {key.upper() for key in fields[5:]}
+                if not state.keys <= set(KEYS):
+                    raise ValueError(f"unknown key in {fields[5:]}")
+                steps.append((float(fields[0]), state))
+            except ValueError as error:
+                raise SystemExit(f"remote_bridge: error: {path}:{number}: {error}")
+    return sorted(steps, key=lambda step: step[0])
+
+
+def run_replay(sender: Sender, path: str, loop: bool) -> None:
+    steps = parse_script(path)
+    if not steps:
+        raise SystemExit(f"remote_bridge: error: {path}: no input lines")
+
+    while True:
+        start = time.monotonic()
+        current = 0
+        while True:
+            elapsed = sender.wait() - start
+            while current + 1 < len(steps) and steps[current + 1][0] <= elapsed:
+                current += 1
+            sender.send(steps[current][1])
+            if current == len(steps) - 1 and elapsed >= steps[-1][0]:
+                break
+        if not loop:
+            return
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Send DR16 frames to the hosted virtual remote.")
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=int(os.environ.get("REMOTE_UDP_PORT", 7001)))
+    parser.add_argument("--rate", type=float, default=70.0, help="frames per second")
+    sources = parser.add_subparsers(dest="source", required=True)
+
+    keyboard = sources.add_parser("keyboard", help="read the terminal's keyboard")
+    keyboard.add_argument("--hold", type=float, default=0.15, help="key hold time in seconds")
+
+    joystick = sources.add_parser("evdev", help="read a joystick input device")
+    joystick.add_argument("device", help="e.g. /dev/input/event5")
+
+    replay = sources.add_parser("replay", help="replay a timed input script")
+    replay.add_argument("script")
+    replay.add_argument("--loop", action="store_true", help="restart the script when it ends")
+
+    args = parser.parse_args()
+    sender = Sender(args.host, args.port, args.rate)
+
+    try:
+        if args.source == "keyboard":
+            run_keyboard(sender, args.hold)
+        elif args.source == "evdev":
+            run_evdev(sender, args.device)
+        else:
+            run_replay(sender, args.script, args.loop)
+    except KeyboardInterrupt:
+        pass
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
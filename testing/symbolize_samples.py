@@ -0,0 +1,187 @@
+"""
+Symbolizes a sampling profiler dump against the firmware ELF and prints where the time went.
+
+Build the firmware with the sampling profiler (scons build sampling_profiler=1), let the robot run
+what you want to profile, then capture the output of the "samples" terminal command into a file.
+
+usage:
+    python3 symbolize_samples.py dump.txt [--elf path/to/firmware.elf] [--top 25] [--lines]
+
+The dump may contain other terminal output; the last "samples ... end" block in it is used. With
+no --elf, the newest .elf under aruw-edu/aruw-edu-project/build is used, which is where deploy.py
+builds. Addresses are resolved with arm-none-eabi-addr2line for ARM firmware and addr2line for a
+hosted build, which also reports where its executable was loaded so PIE addresses resolve.
+
+Functions are ranked by the share of PC samples that landed in them (self time). The LR samples
+rank the callers those samples returned to, which only covers leaf functions and functions that
+had not yet reused LR, and is empty for x86 hosts.
+"""
+
+import argparse
+import glob
+import os
+import shutil
+import subprocess
+import sys
+from collections import Counter
+
+
+DEFAULT_BUILD_DIR = os.path.join(
+    os.path.dirname(os.path.abspath(__file__)), "aruw-edu", "aruw-edu-project", "build")
+
+ELF_MACHINE_ARM = 40
+ELF_MACHINE_AARCH64 = 183
+
+
+class Dump:
+    def __init__(self):
+        self.total = 0
+        self.dropped = 0
+        self.period_us = 0
+        self.base = 0
+        self.pcs = Counter()
+        self.lrs = Counter()
+
+
+def parse_dump(path: str) -> Dump:
+    dump = None
+    last = None
+    with open(path, errors="replace") as lines:
+        for line in lines:
+            fields = line.split()
+            if not fields:
+                continue
+            if fields[0] == "samples" and len(fields) >= 6 and fields[2] == "dropped":
+                dump = Dump()
+                dump.total = int(fields[1])
+                dump.dropped = int(fields[3])
+                dump.period_us = int(fields[5])
+            elif dump is None:
+                continue
+            elif fields[0] == "base":
+                dump.base = int(fields[1], 16)
+            elif fields[0] in ("pc", "lr") and len(fields) == 3:
+                histogram = dump.pcs if fields[0] == "pc" else dump.lrs
+                histogram[int(fields[1], 16)] += int(fields[2])
+            elif fields[0] == "end":
+                last = dump
+                dump = None
+    if last is None:
+        raise SystemExit(f"symbolize_samples: error: {path}: no complete 'samples' dump")
+    return last
+
+
+def find_elf() -> str:
+    candidates = glob.glob(os.path.join(DEFAULT_BUILD_DIR, "**", "*.elf"), recursive=True)
+    if not candidates:
+        raise SystemExit(
+            f"symbolize_samples: error: no .elf under {DEFAULT_BUILD_DIR}, pass --elf")
+    return max(candidates, key=os.path.getmtime)
+
+
+def elf_machine(path: str) -> int:
+    with open(path, "rb") as elf:
+        header = elf.read(20)
+    if header[:4] != b"\x7fELF":
+        raise SystemExit(f"symbolize_samples: error: {path}: not an ELF file")
+    byteorder = "little" if header[5] == 1 else "big"
+    return int.from_bytes(header[18:20], byteorder)
+
+
+def tool(name: str, machine: int) -> str:
+    prefixed = "arm-none-eabi-" + name
+    if machine == ELF_MACHINE_ARM and shutil.which(prefixed):
+        return prefixed
+    return name
+
+
+def executable_start(elf: str, nm: str) -> int:
+    """Link time address of the image start, which the hosted dump's base corresponds to."""
+    output = subprocess.run([nm, elf], capture_output=True, text=True, check=True).stdout
+    for line in output.splitlines():
+        fields = line.split()
+        if len(fields) == 3 and fields[2] == "__executable_start":
+            return int(fields[0], 16)
+    return 0
+
+
+def symbolize(elf: str, addr2line: str, addresses: list[int]) -> dict[int, tuple[str, str]]:
+    if not addresses:
+        return {}
+    output = subprocess.run(
+        [addr2line, "-f", "-C", "-e", elf] + [hex(address) for address in addresses],
+        capture_output=True,
+        text=True,
+        check=True).stdout.splitlines()
+    return {
+        address: (output[2 * ii], output[2 * ii + 1])
+        for ii, address in enumerate(addresses)
+    }
+
+
+def call_site(return_address: int, machine: int) -> int:
+    """Moves a return address back into the call instruction, so it resolves to the call's line."""
+    if machine == ELF_MACHINE_ARM:
+        return (return_address & ~1) - 2
+    if machine == ELF_MACHINE_AARCH64:
+        return return_address - 4
+    return return_address - 1
+
+
+def report(title: str, histogram: Counter, symbols: dict, total: int, top: int, lines: bool):
+    by_function = Counter()
+    by_line = Counter()
+    for address, count in histogram.items():
+        function, location = symbols[address]
+        by_function[function] += count
+        by_line[(function, location)] += count
+
+    print(f"\n{title}")
+    if not histogram:
+        print("  no samples")
+        return
+
+    if lines:
+        for (function, location), count in by_line.most_common(top):
+            print(f"{100 * count / total:6.2f}% {count:8d}  {function}  {location}")
+    else:
+        for function, count in by_function.most_common(top):
+            print(f"{100 * count / total:6.2f}% {count:8d}  {function}")
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Symbolize a sampling profiler dump.")
+    parser.add_argument("dump", help="file holding the 'samples' terminal output")
+    parser.add_argument("--elf", help="firmware ELF (default: newest under the scons build dir)")
+    parser.add_argument("--top", type=int, default=25, help="entries to print per table")
+    parser.add_argument("--lines", action="store_true", help="rank source lines, not functions")
+    args = parser.parse_args()
+
+    dump = parse_dump(args.dump)
+    elf = args.elf or find_elf()
+    machine = elf_machine(elf)
+    addr2line = tool("addr2line", machine)
+
+    # Hosted dumps hold run time addresses of a possibly relocated image
+    offset = 0
+    if dump.base != 0:
+        offset = executable_start(elf, tool("nm", machine)) - dump.base
+
+    pcs = Counter({address + offset: count for address, count in dump.pcs.items()})
+    lrs = Counter({call_site(address + offset, machine): count
+                   for address, count in dump.lrs.items()})
+
+    try:
+        symbols = symbolize(elf, addr2line, sorted(set(pcs) | set(lrs)))
+    except (OSError, subprocess.CalledProcessError) as error:
+        print(f"symbolize_samples: error: {addr2line}: {error}", file=sys.stderr)
+        return 1
+
+    print(f"{elf}: {dump.total} samples every {dump.period_us} us, {dump.dropped} dropped")
+    report("self time (PC):", pcs, symbols, dump.total, args.top, args.lines)
+    report("returning into (LR):", lrs, symbols, dump.total, args.top, args.lines)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,178 @@
+"""
+Converts a trace buffer dump into Chrome trace JSON, to inspect the main loop's timeline.
+
+Let the robot run what you want to look at, optionally "trace stop" to freeze the buffer, then
+capture the output of the "trace" terminal command into a file.
+
+usage:
+    python3 trace_to_json.py dump.txt [-o trace.json] [--summary] [--period-us 2000]
+
+The dump may contain other terminal output; the last "trace ... end" block in it is used. Open the
+JSON at ui.perfetto.dev or chrome://tracing. Each traced scope becomes a slice on one "main loop"
+track, nested as it ran, timestamped in microseconds since the oldest event.
+
+Events are stamped with a 32-bit cycle counter, which is unwrapped assuming consecutive events are
+less than one wrap apart: 23 s at 180 MHz, but only about a second on a fast host. Events whose
+begin was overwritten in the ring, and scopes still open when the dump was taken, are dropped.
+
+--summary prints the period and duration of the "control tick" scope, every tick that started more
+than 10% of --period-us late and every tick that ran longer than --period-us.
+"""
+
+import argparse
+import json
+import statistics
+import sys
+
+
+TICK_NAME = "control tick"
+# Fraction of the period a tick may start late before it is reported
+LATE_SLACK = 0.1
+
+
+class Dump:
+    def __init__(self):
+        self.cycles_khz = 0
+        self.names = {}
+        self.events = []
+
+
+class Slice:
+    def __init__(self, name: str, begin_us: float, end_us: float, depth: int):
+        self.name = name
+        self.begin_us = begin_us
+        self.end_us = end_us
+        self.depth = depth
+
+
+def parse_dump(path: str) -> Dump:
+    dump = None
+    last = None
+    with open(path, errors="replace") as lines:
+        for line in lines:
+            fields = line.split()
+            if not fields:
+                continue
+            if fields[0] == "trace" and len(fields) >= 3 and fields[1] == "cycles_khz":
+                dump = Dump()
+                dump.cycles_khz = int(fields[2])
+            elif dump is None:
+                continue
+            elif fields[0] == "name" and len(fields) >= 3:
+                dump.names[int(fields[1])] = line.split(None, 2)[2].strip()
+            elif fields[0] == "e" and len(fields) == 4:
+                dump.events.append((int(fields[1]), int(fields[2]), fields[3]))
+            elif fields[0] == "end":
+                last = dump
+                dump = None
+    if last is None:
+        raise SystemExit(f"trace_to_json: error: {path}: no complete 'trace' dump")
+    if last.cycles_khz <= 0:
+        raise SystemExit(f"trace_to_json: error: {path}: cycle counter frequency is unknown")
+    return last
+
+
+def build_slices(dump: Dump) -> list[Slice]:
+    slices = []
+    open_scopes = []
+    elapsed = 0
+    previous = None
+    for cycles, name_id, phase in dump.events:
+        if previous is not None:
+            elapsed += (cycles - previous) & 0xFFFFFFFF
+        previous = cycles
+        time_us = elapsed * 1e3 / dump.cycles_khz
+
+        if phase == "B":
+            open_scopes.append((name_id, time_us))
+        elif open_scopes and open_scopes[-1][0] == name_id:
+            begin_name, begin_us = open_scopes.pop()
+            name = dump.names.get(begin_name, f"#{begin_name}")
+            slices.append(Slice(name, begin_us, time_us, len(open_scopes)))
+        elif not open_scopes:
+            # Its begin was overwritten before the dump
+            continue
+        else:
+            raise SystemExit(
+                f"trace_to_json: error: end of #{name_id} does not match the open scope "
+                f"#{open_scopes[-1][0]}; was the buffer reset while recording?")
+    return sorted(slices, key=lambda scope: (scope.begin_us, scope.depth))
+
+
+def to_chrome_trace(slices: list[Slice]) -> dict:
+    events = [
+        {"ph": "M", "pid": 1, "tid": 1, "name": "process_name", "args": {"name": "controller"}},
+        {"ph": "M", "pid": 1, "tid": 1, "name": "thread_name", "args": {"name": "main loop"}},
+    ]
+    for scope in slices:
+        events.append({
+            "ph": "X",
+            "pid": 1,
+            "tid": 1,
+            "name": scope.name,
+            "ts": round(scope.begin_us, 3),
+            "dur": round(scope.end_us - scope.begin_us, 3),
+        })
+    return {"traceEvents": events, "displayTimeUnit": "ns"}
+
+
+def describe(values: list[float]) -> str:
+    deviation = statistics.pstdev(values) if len(values) > 1 else 0.0
+    return (f"min {min(values):.1f} / mean {statistics.fmean(values):.1f} / "
+            f"max {max(values):.1f} us, std {deviation:.1f} us")
+
+
+def print_summary(slices: list[Slice], period_us: float) -> None:
+    durations = {}
+    for scope in slices:
+        durations.setdefault(scope.name, []).append(scope.end_us - scope.begin_us)
+
+    print("durations:")
+    for name, values in durations.items():
+        print(f"  {name}: {describe(values)} ({len(values)} calls)")
+
+    ticks = [scope for scope in slices if scope.name == TICK_NAME]
+    if len(ticks) < 2:
+        print(f"fewer than two '{TICK_NAME}' scopes, no period to report")
+        return
+
+    periods = [after.begin_us - before.begin_us for before, after in zip(ticks, ticks[1:])]
+    print(f"{TICK_NAME} period: {describe(periods)}")
+
+    late = [(tick, period) for tick, period in zip(ticks[1:], periods)
+            if period > period_us * (1 + LATE_SLACK)]
+    long = [tick for tick in ticks if tick.end_us - tick.begin_us > period_us]
+    print(f"{len(late)} ticks started late and {len(long)} ran longer than {period_us:g} us")
+    for tick, period in late:
+        print(f"  late at {tick.begin_us:.1f} us, {period:.1f} us after the previous tick")
+    for tick in long:
+        print(f"  long at {tick.begin_us:.1f} us, ran {tick.end_us - tick.begin_us:.1f} us")
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Convert a trace dump to Chrome trace JSON.")
+    parser.add_argument("dump", help="file holding the 'trace' terminal output")
+    parser.add_argument("-o", "--output", help="JSON file to write (default: dump name + .json)")
+    parser.add_argument("--summary", action="store_true", help="print tick timing statistics")
+    parser.add_argument(
+        "--period-us",
+        type=float,
+        default=2000.0,
+        help="nominal control tick period, above which a tick counts as an overrun")
+    args = parser.parse_args()
+
+    dump = parse_dump(args.dump)
+    slices = build_slices(dump)
+    output = args.output or args.dump.rsplit(".", 1)[0] + ".json"
+
+    with open(output, "w") as trace:
+        json.dump(to_chrome_trace(slices), trace)
+    print(f"{output}: {len(slices)} slices from {len(dump.events)} events")
+
+    if args.summary:
+        print_summary(slices, args.period_us)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())